@@ -0,0 +1,79 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Фоновый поток, который освобождает память вместо потоков, чувствительных к задержкам.
+// Задачи выполняются по одной в порядке поступления
+class BackgroundReclaimer {
+public:
+    // Общий экземпляр на всю программу. Поток запускается при первом обращении.
+    // Экземпляр не разрушается при завершении программы, чтобы списки в статических
+    // объектах могли передавать ему узлы из своих деструкторов
+    static BackgroundReclaimer& Instance() {
+        static BackgroundReclaimer* instance = new BackgroundReclaimer();
+        return *instance;
+    }
+
+    BackgroundReclaimer(const BackgroundReclaimer&) = delete;
+    BackgroundReclaimer& operator=(const BackgroundReclaimer&) = delete;
+
+    // Ставит задачу в очередь. Задача не должна выбрасывать исключений
+    void Submit(std::function<void()> job) {
+        {
+            std::lock_guard guard(mutex_);
+            jobs_.push_back(std::move(job));
+        }
+        has_jobs_.notify_one();
+    }
+
+    // Ждёт, пока не будут выполнены все поставленные задачи
+    void Flush() {
+        std::unique_lock lock(mutex_);
+        idle_.wait(lock, [this] {
+            return jobs_.empty() && !busy_;
+        });
+    }
+
+private:
+    BackgroundReclaimer()
+        : worker_([this] {
+            Run();
+        }) {
+    }
+
+    // Забирает из очереди все накопившиеся задачи разом, чтобы не захватывать мьютекс на каждую
+    void Run() {
+        std::vector<std::function<void()>> batch;
+        std::unique_lock lock(mutex_);
+        while (true) {
+            has_jobs_.wait(lock, [this] {
+                return !jobs_.empty();
+            });
+            batch.swap(jobs_);
+            busy_ = true;
+            lock.unlock();
+            for (auto& job : batch) {
+                job();
+            }
+            batch.clear();
+            lock.lock();
+            busy_ = false;
+            if (jobs_.empty()) {
+                idle_.notify_all();
+            }
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable has_jobs_;
+    std::condition_variable idle_;
+    std::vector<std::function<void()>> jobs_;
+    bool busy_ = false;
+    // Поток запускается последним, когда остальные поля уже созданы
+    std::thread worker_;
+};
@@ -0,0 +1,1242 @@
+// Замеры производительности SingleLinkedList в сравнении с std::forward_list и std::vector.
+// Сборка: g++ -std=c++17 -O2 -DNDEBUG -pthread benchmark.cpp -o benchmark
+// Запуск: ./benchmark [максимальный размер] [подстрока фильтра]
+// Каждая строка вывода - JSON-объект с результатом одного замера:
+// контейнер, тип элемента, размер, операция, ns/op, операций в секунду и выделений памяти на операцию
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <forward_list>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <new>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "background-reclaimer.h"
+#include "compact-single-linked-list.h"
+#include "concurrent-single-linked-list.h"
+#include "indexed-single-linked-list.h"
+#include "hash-indexed-single-linked-list.h"
+#include "intrusive-single-linked-list.h"
+#include "list-serialization.h"
+#include "list-views.h"
+#include "mpsc-queue.h"
+#include "node-pool.h"
+#include "persistent-single-linked-list.h"
+#include "single-linked-list.h"
+#include "unrolled-linked-list.h"
+#include "work-stealing-pool.h"
+
+namespace {
+
+std::atomic<size_t> allocation_count{ 0 };
+
+}  // namespace
+
+// Глобальные operator new считают выделения памяти, чтобы их можно было отнести к операции
+void* operator new(size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t align) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    const size_t alignment = static_cast<size_t>(align);
+    if (void* ptr = std::aligned_alloc(alignment, (std::max<size_t>(size, 1) + alignment - 1) / alignment * alignment)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+// Освобождение вынесено в отдельную функцию, чтобы компилятор не сопоставлял
+// встроенный free с operator new в местах вызова
+namespace {
+
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void Deallocate(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+}  // namespace
+
+void operator delete(void* ptr) noexcept {
+    Deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    Deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    Deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+    Deallocate(ptr);
+}
+
+namespace {
+
+// Объём памяти под элементы одного контейнера, больше которого замер пропускается
+constexpr size_t MEMORY_BUDGET = size_t{ 512 } << 20;
+// Минимальное число операций на замер: маленькие размеры повторяются несколько раз
+constexpr size_t TARGET_OPS = 1'000'000;
+
+template <typename T>
+void DoNotOptimize(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+struct Pod256 {
+    std::array<unsigned char, 256> bytes;
+};
+
+bool operator==(const Pod256& lhs, const Pod256& rhs) {
+    return lhs.bytes == rhs.bytes;
+}
+
+bool operator<(const Pod256& lhs, const Pod256& rhs) {
+    return lhs.bytes < rhs.bytes;
+}
+
+template <typename T>
+T MakeValue(size_t i);
+
+template <>
+int MakeValue<int>(size_t i) {
+    return static_cast<int>(i);
+}
+
+// Строки длиннее буфера SSO, чтобы каждая копия выделяла память
+template <>
+std::string MakeValue<std::string>(size_t i) {
+    return std::string(32, 'a') + std::to_string(i);
+}
+
+template <>
+Pod256 MakeValue<Pod256>(size_t i) {
+    Pod256 pod{};
+    pod.bytes.fill(static_cast<unsigned char>(i));
+    return pod;
+}
+
+template <typename T>
+size_t Touch(const T& value) {
+    if constexpr (std::is_same_v<T, int>) {
+        return static_cast<size_t>(value);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        return value.size();
+    } else {
+        return value.bytes[0];
+    }
+}
+
+template <typename T>
+std::vector<T> MakeValues(size_t count) {
+    std::vector<T> values;
+    values.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        values.push_back(MakeValue<T>(i));
+    }
+    return values;
+}
+
+// Адаптеры приводят контейнеры к общему набору операций.
+// std::vector не умеет вставлять в начало за O(1), поэтому для него
+// используются естественные аналоги в конце: push_back и pop_back
+template <typename Container>
+struct ListAdapter {
+    using T = typename Container::value_type;
+
+    static void PushFront(Container& c, const T& value) {
+        c.PushFront(value);
+    }
+
+    static void InsertSequence(Container& c, const std::vector<T>& values) {
+        auto pos = c.cbefore_begin();
+        for (const T& value : values) {
+            pos = c.InsertAfter(pos, value);
+        }
+    }
+
+    static void EraseFront(Container& c, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            c.EraseAfter(c.cbefore_begin());
+        }
+    }
+
+    static void Clear(Container& c) {
+        c.Clear();
+    }
+};
+
+template <typename T>
+struct ForwardListAdapter {
+    using Container = std::forward_list<T>;
+
+    static void PushFront(Container& c, const T& value) {
+        c.push_front(value);
+    }
+
+    static void InsertSequence(Container& c, const std::vector<T>& values) {
+        auto pos = c.cbefore_begin();
+        for (const T& value : values) {
+            pos = c.insert_after(pos, value);
+        }
+    }
+
+    static void EraseFront(Container& c, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            c.erase_after(c.cbefore_begin());
+        }
+    }
+
+    static void Clear(Container& c) {
+        c.clear();
+    }
+};
+
+template <typename T>
+struct VectorAdapter {
+    using Container = std::vector<T>;
+
+    static void PushFront(Container& c, const T& value) {
+        c.push_back(value);
+    }
+
+    static void InsertSequence(Container& c, const std::vector<T>& values) {
+        for (const T& value : values) {
+            c.push_back(value);
+        }
+    }
+
+    static void EraseFront(Container& c, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            c.pop_back();
+        }
+    }
+
+    static void Clear(Container& c) {
+        c.clear();
+    }
+};
+
+// Накапливает время и число выделений памяти внутри замеряемых участков
+class Stopwatch {
+public:
+    void Start() noexcept {
+        allocations_at_start_ = allocation_count.load(std::memory_order_relaxed);
+        start_ = std::chrono::steady_clock::now();
+    }
+
+    void Stop() noexcept {
+        elapsed_ += std::chrono::steady_clock::now() - start_;
+        allocations_ += allocation_count.load(std::memory_order_relaxed) - allocations_at_start_;
+    }
+
+    [[nodiscard]] double Nanoseconds() const noexcept {
+        return std::chrono::duration<double, std::nano>(elapsed_).count();
+    }
+
+    [[nodiscard]] size_t Allocations() const noexcept {
+        return allocations_;
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::steady_clock::duration elapsed_{};
+    size_t allocations_at_start_ = 0;
+    size_t allocations_ = 0;
+};
+
+struct BenchmarkConfig {
+    size_t max_size = 10'000'000;
+    std::string_view filter;
+};
+
+// ns_per_op считается по времени всего замера, поэтому при нескольких потоках
+// это обратная величина суммарной пропускной способности
+void Report(std::string_view container, std::string_view type, size_t size, std::string_view op,
+            size_t ops, const Stopwatch& stopwatch, size_t threads = 1) {
+    const double ns_per_op = stopwatch.Nanoseconds() / static_cast<double>(ops);
+    std::printf("{\"container\":\"%.*s\",\"type\":\"%.*s\",\"size\":%zu,\"op\":\"%.*s\",\"threads\":%zu,"
+                "\"ops\":%zu,\"ns_per_op\":%.3f,\"ops_per_sec\":%.0f,\"allocs_per_op\":%.4f}\n",
+                static_cast<int>(container.size()), container.data(),
+                static_cast<int>(type.size()), type.data(), size,
+                static_cast<int>(op.size()), op.data(), threads, ops, ns_per_op,
+                ns_per_op > 0 ? 1e9 / ns_per_op : 0.0,
+                static_cast<double>(stopwatch.Allocations()) / static_cast<double>(ops));
+    std::fflush(stdout);
+}
+
+template <typename Container, typename Adapter>
+void RunContainer(std::string_view container_name, std::string_view type_name, size_t size) {
+    using T = typename Container::value_type;
+    const std::vector<T> values = MakeValues<T>(size);
+    const size_t reps = std::max<size_t>(1, TARGET_OPS / size);
+    const size_t ops = reps * size;
+
+    const auto build = [&values] {
+        Container c;
+        Adapter::InsertSequence(c, values);
+        return c;
+    };
+
+    {
+        Stopwatch stopwatch;
+        for (size_t rep = 0; rep < reps; ++rep) {
+            Container c;
+            stopwatch.Start();
+            for (const T& value : values) {
+                Adapter::PushFront(c, value);
+            }
+            stopwatch.Stop();
+            DoNotOptimize(c);
+        }
+        Report(container_name, type_name, size, "PushFront", ops, stopwatch);
+    }
+    {
+        Stopwatch stopwatch;
+        for (size_t rep = 0; rep < reps; ++rep) {
+            Container c;
+            stopwatch.Start();
+            Adapter::InsertSequence(c, values);
+            stopwatch.Stop();
+            DoNotOptimize(c);
+        }
+        Report(container_name, type_name, size, "InsertAfter", ops, stopwatch);
+    }
+    {
+        Stopwatch stopwatch;
+        for (size_t rep = 0; rep < reps; ++rep) {
+            Container c = build();
+            stopwatch.Start();
+            Adapter::EraseFront(c, size);
+            stopwatch.Stop();
+            DoNotOptimize(c);
+        }
+        Report(container_name, type_name, size, "EraseAfter", ops, stopwatch);
+    }
+    {
+        Stopwatch stopwatch;
+        for (size_t rep = 0; rep < reps; ++rep) {
+            Container c = build();
+            stopwatch.Start();
+            Adapter::Clear(c);
+            stopwatch.Stop();
+            DoNotOptimize(c);
+        }
+        Report(container_name, type_name, size, "Clear", ops, stopwatch);
+    }
+
+    const Container source = build();
+    {
+        Stopwatch stopwatch;
+        // Буфер под копию выделяется заранее, разрушение копии не замеряется
+        std::vector<Container> copies;
+        copies.reserve(1);
+        for (size_t rep = 0; rep < reps; ++rep) {
+            stopwatch.Start();
+            copies.emplace_back(source);
+            stopwatch.Stop();
+            DoNotOptimize(copies.back());
+            copies.clear();
+        }
+        Report(container_name, type_name, size, "CopyConstruct", ops, stopwatch);
+    }
+    {
+        Stopwatch stopwatch;
+        for (size_t rep = 0; rep < reps; ++rep) {
+            Container target;
+            Adapter::PushFront(target, values.front());
+            stopwatch.Start();
+            target = source;
+            stopwatch.Stop();
+            DoNotOptimize(target);
+        }
+        Report(container_name, type_name, size, "CopyAssign", ops, stopwatch);
+    }
+    {
+        Stopwatch stopwatch;
+        size_t checksum = 0;
+        stopwatch.Start();
+        for (size_t rep = 0; rep < reps; ++rep) {
+            for (const T& value : source) {
+                checksum += Touch(value);
+            }
+        }
+        stopwatch.Stop();
+        DoNotOptimize(checksum);
+        Report(container_name, type_name, size, "Iterate", ops, stopwatch);
+    }
+
+    const Container same = source;
+    {
+        Stopwatch stopwatch;
+        size_t equal_count = 0;
+        stopwatch.Start();
+        for (size_t rep = 0; rep < reps; ++rep) {
+            // Барьер не даёт компилятору вынести сравнение неизменных списков из цикла
+            DoNotOptimize(same);
+            equal_count += source == same;
+        }
+        stopwatch.Stop();
+        DoNotOptimize(equal_count);
+        Report(container_name, type_name, size, "Equal", ops, stopwatch);
+    }
+    {
+        Stopwatch stopwatch;
+        size_t less_count = 0;
+        stopwatch.Start();
+        for (size_t rep = 0; rep < reps; ++rep) {
+            DoNotOptimize(same);
+            less_count += source < same;
+        }
+        stopwatch.Stop();
+        DoNotOptimize(less_count);
+        Report(container_name, type_name, size, "Less", ops, stopwatch);
+    }
+    {
+        // Список длиннее на один элемент с тем же началом: при дедупликации такие пары отсекаются по размеру
+        std::vector<T> longer_values = values;
+        longer_values.push_back(values.back());
+        Container longer;
+        Adapter::InsertSequence(longer, longer_values);
+        Stopwatch stopwatch;
+        size_t equal_count = 0;
+        stopwatch.Start();
+        for (size_t rep = 0; rep < reps; ++rep) {
+            DoNotOptimize(longer);
+            equal_count += source == longer;
+        }
+        stopwatch.Stop();
+        DoNotOptimize(equal_count);
+        Report(container_name, type_name, size, "EqualDifferentSize", ops, stopwatch);
+    }
+}
+
+// Время ClearAsync в вызывающем потоке. Фоновое освобождение дожидается вне замера
+template <typename List>
+void RunClearAsync(std::string_view container_name, std::string_view type_name, size_t size) {
+    using T = typename List::value_type;
+    const std::vector<T> values = MakeValues<T>(size);
+    const size_t reps = std::max<size_t>(1, TARGET_OPS / size);
+    Stopwatch stopwatch;
+    for (size_t rep = 0; rep < reps; ++rep) {
+        List list(values.begin(), values.end());
+        stopwatch.Start();
+        list.ClearAsync();
+        stopwatch.Stop();
+        DoNotOptimize(list);
+        BackgroundReclaimer::Instance().Flush();
+    }
+    Report(container_name, type_name, size, "ClearAsync", reps * size, stopwatch);
+}
+
+// Обход списка, узлы которого разбросаны по памяти: обычный, с предвыборкой и после Compact.
+// Узлы перемешиваются сортировкой случайных значений, которая перецепляет узлы, не перемещая их
+template <typename List>
+void RunFragmentedScan(std::string_view container_name, size_t size) {
+    constexpr size_t SCANS = 5;
+    List list;
+    uint64_t state = 1;
+    for (size_t i = 0; i < size; ++i) {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        list.PushFront(static_cast<int>(state >> 33));
+    }
+    list.Sort();
+
+    const auto scan = [&list, container_name, size](std::string_view op, auto&& range) {
+        Stopwatch stopwatch;
+        size_t checksum = 0;
+        stopwatch.Start();
+        for (size_t rep = 0; rep < SCANS; ++rep) {
+            for (const int& value : range()) {
+                checksum += static_cast<size_t>(value);
+            }
+        }
+        stopwatch.Stop();
+        DoNotOptimize(checksum);
+        DoNotOptimize(list);
+        Report(container_name, "int", size, op, SCANS * size, stopwatch);
+    };
+    const auto plain = [&list]() -> const List& {
+        return list;
+    };
+    const auto prefetched = [&list] {
+        return std::as_const(list).Prefetched();
+    };
+
+    scan("ScanFragmented", plain);
+    scan("ScanFragmentedPrefetch", prefetched);
+    {
+        Stopwatch stopwatch;
+        stopwatch.Start();
+        list.Compact();
+        stopwatch.Stop();
+        Report(container_name, "int", size, "Compact", size, stopwatch);
+    }
+    scan("ScanCompacted", plain);
+    scan("ScanCompactedPrefetch", prefetched);
+}
+
+bool IsSelected(const BenchmarkConfig& config, std::string_view container_name, std::string_view type_name) {
+    return config.filter.empty()
+        || container_name.find(config.filter) != std::string_view::npos
+        || type_name.find(config.filter) != std::string_view::npos;
+}
+
+template <typename T>
+void RunType(std::string_view type_name, const BenchmarkConfig& config) {
+    using List = SingleLinkedList<T>;
+    using PooledList = SingleLinkedList<T, PoolAllocator<T>>;
+    using Unrolled = UnrolledLinkedList<T>;
+
+    const auto selected = [&config, type_name](std::string_view container_name) {
+        return IsSelected(config, container_name, type_name);
+    };
+
+    for (size_t size = 10; size <= config.max_size; size *= 10) {
+        if (size * sizeof(T) > MEMORY_BUDGET) {
+            break;
+        }
+        if (selected("SingleLinkedList")) {
+            RunContainer<List, ListAdapter<List>>("SingleLinkedList", type_name, size);
+            RunClearAsync<List>("SingleLinkedList", type_name, size);
+        }
+        if (selected("SingleLinkedList<PoolAllocator>")) {
+            RunContainer<PooledList, ListAdapter<PooledList>>("SingleLinkedList<PoolAllocator>", type_name, size);
+        }
+        if (selected("UnrolledLinkedList")) {
+            RunContainer<Unrolled, ListAdapter<Unrolled>>("UnrolledLinkedList", type_name, size);
+        }
+        if (selected("std::forward_list")) {
+            RunContainer<std::forward_list<T>, ForwardListAdapter<T>>("std::forward_list", type_name, size);
+        }
+        if (selected("std::vector")) {
+            RunContainer<std::vector<T>, VectorAdapter<T>>("std::vector", type_name, size);
+        }
+    }
+}
+
+// Загрузка сохранённого списка при старте: поэлементная вставка с разворотом, копирование из вектора,
+// чтение из потока и отображение файла в память
+template <typename List>
+void RunColdLoad(std::string_view container_name, size_t size) {
+    std::vector<int> values(size);
+    for (size_t i = 0; i < size; ++i) {
+        values[i] = MakeValue<int>(i);
+    }
+    List source(values.begin(), values.end());
+    std::stringstream stream;
+    Serialize(stream, source);
+    const std::string bytes = stream.str();
+    const std::string path = "benchmark-cold-load.bin";
+    SaveToFile(path, source);
+
+    auto measure = [&](std::string_view op, auto load) {
+        List list;
+        Stopwatch stopwatch;
+        stopwatch.Start();
+        load(list);
+        stopwatch.Stop();
+        DoNotOptimize(list);
+        Report(container_name, "int", size, op, size, stopwatch);
+    };
+    measure("LoadPushFrontReverse", [&values](List& list) {
+        for (auto it = values.rbegin(); it != values.rend(); ++it) {
+            list.PushFront(*it);
+        }
+    });
+    measure("LoadCopyFromVector", [&values](List& list) {
+        list.Assign(values.begin(), values.end());
+    });
+    measure("LoadDeserialize", [&bytes](List& list) {
+        std::istringstream input(bytes);
+        Deserialize(input, list);
+    });
+    measure("LoadFromFile", [&path](List& list) {
+        LoadFromFile(path, list);
+    });
+    std::remove(path.c_str());
+}
+
+// Упорядоченная вставка случайных значений и чтение по случайным номерам:
+// у SingleLinkedList каждая операция проходит список от начала, у IndexedSingleLinkedList - O(√N) элементов
+void RunOrderedInsert(size_t size) {
+    std::mt19937 generator(42);
+    std::vector<int> values(size);
+    for (int& value : values) {
+        value = static_cast<int>(generator());
+    }
+    std::vector<size_t> positions(size);
+    for (size_t& position : positions) {
+        position = generator() % size;
+    }
+
+    // Линейный проход при N в сотни тысяч занимает минуты, поэтому он замеряется только на малых размерах
+    if (size <= 10'000) {
+        SingleLinkedList<int> list;
+        Stopwatch stopwatch;
+        stopwatch.Start();
+        for (int value : values) {
+            auto prev = list.cbefore_begin();
+            for (auto it = list.cbegin(); it != list.cend() && *it < value; ++it) {
+                prev = it;
+            }
+            list.InsertAfter(prev, value);
+        }
+        stopwatch.Stop();
+        Report("SingleLinkedList", "int", size, "OrderedInsert", size, stopwatch);
+
+        size_t checksum = 0;
+        Stopwatch at_stopwatch;
+        at_stopwatch.Start();
+        for (size_t position : positions) {
+            checksum += static_cast<size_t>(*std::next(list.cbegin(), static_cast<std::ptrdiff_t>(position)));
+        }
+        at_stopwatch.Stop();
+        DoNotOptimize(checksum);
+        Report("SingleLinkedList", "int", size, "At", size, at_stopwatch);
+    }
+
+    IndexedSingleLinkedList<int> indexed;
+    Stopwatch stopwatch;
+    stopwatch.Start();
+    for (int value : values) {
+        indexed.InsertSorted(value);
+    }
+    stopwatch.Stop();
+    Report("IndexedSingleLinkedList", "int", size, "OrderedInsert", size, stopwatch);
+
+    size_t checksum = 0;
+    Stopwatch at_stopwatch;
+    at_stopwatch.Start();
+    for (size_t position : positions) {
+        checksum += static_cast<size_t>(indexed.At(position));
+    }
+    at_stopwatch.Stop();
+    DoNotOptimize(checksum);
+    Report("IndexedSingleLinkedList", "int", size, "At", size, at_stopwatch);
+}
+
+// Список идентификаторов сессий: проверка присутствия случайного идентификатора (половина - промахи)
+// и замена сессии - удаление по значению и вставка нового идентификатора в начало
+void RunSessionLookup(size_t size) {
+    const size_t ops = std::max<size_t>(100, std::min<size_t>(TARGET_OPS, 100'000'000 / size));
+    std::mt19937 generator(7);
+    std::vector<int> queries(ops);
+    for (int& query : queries) {
+        query = static_cast<int>(generator() % (2 * size));
+    }
+    std::vector<int> ids(size);
+    for (size_t i = 0; i < size; ++i) {
+        ids[i] = static_cast<int>(i);
+    }
+
+    auto measure = [&](std::string_view container_name, auto& list, auto contains, auto erase_value) {
+        size_t hits = 0;
+        Stopwatch contains_stopwatch;
+        contains_stopwatch.Start();
+        for (int query : queries) {
+            hits += contains(list, query);
+        }
+        contains_stopwatch.Stop();
+        DoNotOptimize(hits);
+        Report(container_name, "int", size, "ContainsValue", ops, contains_stopwatch);
+
+        // Случайный идентификатор заменяется идентификатором, которого в списке нет
+        int next_id = static_cast<int>(2 * size);
+        Stopwatch erase_stopwatch;
+        erase_stopwatch.Start();
+        for (int query : queries) {
+            int& id = ids[static_cast<size_t>(query) % size];
+            erase_value(list, id);
+            list.PushFront(next_id);
+            id = next_id++;
+        }
+        erase_stopwatch.Stop();
+        Report(container_name, "int", size, "EraseValuePushFront", ops, erase_stopwatch);
+    };
+
+    {
+        SingleLinkedList<int> list(ids.begin(), ids.end());
+        measure("SingleLinkedList", list, [](const SingleLinkedList<int>& list, int value) {
+            return std::find(list.begin(), list.end(), value) != list.end();
+        }, [](SingleLinkedList<int>& list, int value) {
+            auto prev = list.cbefore_begin();
+            for (auto it = list.cbegin(); *it != value; ++it) {
+                prev = it;
+            }
+            list.EraseAfter(prev);
+        });
+    }
+    for (size_t i = 0; i < size; ++i) {
+        ids[i] = static_cast<int>(i);
+    }
+    {
+        HashIndexedSingleLinkedList<int> list(SingleLinkedList<int>(ids.begin(), ids.end()));
+        measure("HashIndexedSingleLinkedList", list, [](const HashIndexedSingleLinkedList<int>& list, int value) {
+            return list.Contains(value);
+        }, [](HashIndexedSingleLinkedList<int>& list, int value) {
+            list.EraseValue(value);
+        });
+    }
+}
+
+// Объект, который уже лежит в куче и принадлежит кому-то ещё
+struct OwnedObject : IntrusiveListHook<> {
+    explicit OwnedObject(int value)
+        : value(value) {
+    }
+
+    int value;
+};
+
+// Связывание готовых объектов в список и обход: SingleLinkedList<T*> выделяет узел на каждый объект
+// и разыменовывает два указателя на элемент, интрузивный список только перецепляет звенья объектов
+void RunIntrusive(size_t size) {
+    std::vector<std::unique_ptr<OwnedObject>> objects;
+    objects.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        objects.push_back(std::make_unique<OwnedObject>(static_cast<int>(i)));
+    }
+    const size_t reps = std::max<size_t>(1, TARGET_OPS / size);
+
+    auto measure = [&](std::string_view container_name, auto make_list, auto link, auto read) {
+        Stopwatch link_stopwatch;
+        Stopwatch scan_stopwatch;
+        size_t checksum = 0;
+        for (size_t rep = 0; rep < reps; ++rep) {
+            auto list = make_list();
+            link_stopwatch.Start();
+            for (const auto& object : objects) {
+                link(list, *object);
+            }
+            link_stopwatch.Stop();
+            scan_stopwatch.Start();
+            for (const auto& element : list) {
+                checksum += static_cast<size_t>(read(element));
+            }
+            scan_stopwatch.Stop();
+        }
+        DoNotOptimize(checksum);
+        Report(container_name, "OwnedObject", size, "LinkPushFront", reps * size, link_stopwatch);
+        Report(container_name, "OwnedObject", size, "Iterate", reps * size, scan_stopwatch);
+    };
+    measure("SingleLinkedList<T*>", [] {
+        return SingleLinkedList<OwnedObject*>();
+    }, [](SingleLinkedList<OwnedObject*>& list, OwnedObject& object) {
+        list.PushFront(&object);
+    }, [](const OwnedObject* object) {
+        return object->value;
+    });
+    measure("IntrusiveSingleLinkedList", [] {
+        return IntrusiveSingleLinkedList<OwnedObject>();
+    }, [](IntrusiveSingleLinkedList<OwnedObject>& list, OwnedObject& object) {
+        list.PushFront(object);
+    }, [](const OwnedObject& object) {
+        return object.value;
+    });
+}
+
+// Снимок списка, который получает другой поток: копия, вставка в начало копии и разрушение копии.
+// ns_per_op - время одного снимка целиком, а не одного элемента
+template <typename List>
+void RunSnapshots(std::string_view container_name, size_t size) {
+    const std::vector<int> values(size, 1);
+    const List list(values.begin(), values.end());
+    const size_t reps = std::max<size_t>(10, TARGET_OPS / size);
+    size_t checksum = 0;
+    Stopwatch stopwatch;
+    stopwatch.Start();
+    for (size_t rep = 0; rep < reps; ++rep) {
+        List snapshot = list;
+        snapshot.PushFront(static_cast<int>(rep));
+        checksum += snapshot.GetSize() + static_cast<size_t>(*snapshot.begin());
+    }
+    stopwatch.Stop();
+    DoNotOptimize(checksum);
+    Report(container_name, "int", size, "SnapshotCopy", reps, stopwatch);
+}
+
+// Длинный список 32-битных значений: построение добавлением в конец, обход
+// и замена каждого второго элемента через EraseAfter и InsertAfter
+template <typename List>
+void RunLargeList(std::string_view container_name, size_t size) {
+    List list;
+    {
+        Stopwatch stopwatch;
+        stopwatch.Start();
+        for (size_t i = 0; i < size; ++i) {
+            list.PushBack(static_cast<uint32_t>(i));
+        }
+        stopwatch.Stop();
+        Report(container_name, "uint32_t", size, "BuildPushBack", size, stopwatch);
+    }
+    {
+        Stopwatch stopwatch;
+        uint64_t checksum = 0;
+        stopwatch.Start();
+        for (uint32_t value : list) {
+            checksum += value;
+        }
+        stopwatch.Stop();
+        DoNotOptimize(checksum);
+        Report(container_name, "uint32_t", size, "Iterate", size, stopwatch);
+    }
+    {
+        Stopwatch stopwatch;
+        stopwatch.Start();
+        for (auto it = list.cbegin(); it != list.cend(); ++it) {
+            const uint32_t value = *std::next(it) + 1;
+            list.EraseAfter(it);
+            it = list.InsertAfter(it, value);
+            if (std::next(it) == list.cend()) {
+                break;
+            }
+        }
+        stopwatch.Stop();
+        Report(container_name, "uint32_t", size, "EraseInsertAfter", size / 2, stopwatch);
+    }
+}
+
+// Три стадии обработки списка: отбор чётных, преобразование и первые size / 4 результатов.
+// Без представлений каждая стадия строит новый список, с ними список строит только Collect
+void RunPipeline(size_t size) {
+    SingleLinkedList<int> source;
+    for (size_t i = 0; i < size; ++i) {
+        source.PushFront(static_cast<int>(i));
+    }
+    const size_t limit = size / 4;
+    const auto is_even = [](int value) {
+        return value % 2 == 0;
+    };
+    const auto scale = [](int value) {
+        return value * 3 + 1;
+    };
+    const size_t reps = std::max<size_t>(1, TARGET_OPS / size);
+
+    Stopwatch eager_stopwatch;
+    eager_stopwatch.Start();
+    for (size_t rep = 0; rep < reps; ++rep) {
+        SingleLinkedList<int> filtered;
+        for (int value : source) {
+            if (is_even(value)) {
+                filtered.PushBack(value);
+            }
+        }
+        SingleLinkedList<int> transformed;
+        for (int value : filtered) {
+            transformed.PushBack(scale(value));
+        }
+        SingleLinkedList<int> taken;
+        for (auto it = transformed.begin(); it != transformed.end() && taken.GetSize() < limit; ++it) {
+            taken.PushBack(*it);
+        }
+        DoNotOptimize(taken);
+    }
+    eager_stopwatch.Stop();
+    Report("SingleLinkedList", "int", size, "PipelineEager", reps * size, eager_stopwatch);
+
+    Stopwatch lazy_stopwatch;
+    lazy_stopwatch.Start();
+    for (size_t rep = 0; rep < reps; ++rep) {
+        auto taken = Lazy(source).Filter(is_even).Transform(scale).Take(limit).Collect();
+        DoNotOptimize(taken);
+    }
+    lazy_stopwatch.Stop();
+    Report("LazyView", "int", size, "PipelineLazy", reps * size, lazy_stopwatch);
+
+    Stopwatch pooled_stopwatch;
+    pooled_stopwatch.Start();
+    for (size_t rep = 0; rep < reps; ++rep) {
+        auto taken = Lazy(source).Filter(is_even).Transform(scale).Take(limit).Collect(PoolAllocator<int>());
+        DoNotOptimize(taken);
+    }
+    pooled_stopwatch.Stop();
+    Report("LazyView<PoolAllocator>", "int", size, "PipelineLazy", reps * size, pooled_stopwatch);
+}
+
+// Множество коротких списков из 0-4 элементов: каждый список создаётся, заполняется и разрушается
+template <typename List>
+void RunSmallLists(std::string_view container_name) {
+    constexpr size_t LISTS = 1'000'000;
+    constexpr size_t MAX_LENGTH = 4;
+    Stopwatch stopwatch;
+    size_t ops = 0;
+    size_t checksum = 0;
+    stopwatch.Start();
+    for (size_t i = 0; i < LISTS; ++i) {
+        List list;
+        const size_t length = i % (MAX_LENGTH + 1);
+        for (size_t k = 0; k < length; ++k) {
+            list.PushFront(static_cast<int>(k));
+        }
+        checksum += list.GetSize();
+        DoNotOptimize(list);
+        ops += length;
+    }
+    stopwatch.Stop();
+    DoNotOptimize(checksum);
+    Report(container_name, "int", MAX_LENGTH, "SmallListPushFront", ops, stopwatch);
+}
+
+// Вычислительно тяжёлая обработка элемента для замера параллельных алгоритмов
+int HeavyWork(int value) {
+    uint32_t state = static_cast<uint32_t>(value) | 1u;
+    for (int i = 0; i < 200; ++i) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+    }
+    return static_cast<int>(state >> 1);
+}
+
+// ForEach, TransformInPlace и Reduce над длинным списком на пулах от 1 до количества аппаратных потоков
+void RunParallelScaling(size_t size) {
+    const size_t max_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    std::vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    SingleLinkedList<int> list;
+    for (size_t i = 0; i < size; ++i) {
+        list.PushFront(static_cast<int>(i));
+    }
+    for (size_t thread_count : thread_counts) {
+        WorkStealingPool pool(thread_count - 1);
+        {
+            Stopwatch stopwatch;
+            stopwatch.Start();
+            list.ForEach(pool, [](int& value) {
+                value = HeavyWork(value);
+            });
+            stopwatch.Stop();
+            Report("SingleLinkedList", "int", size, "ParallelForEach", size, stopwatch, thread_count);
+        }
+        {
+            Stopwatch stopwatch;
+            stopwatch.Start();
+            list.TransformInPlace(pool, HeavyWork);
+            stopwatch.Stop();
+            Report("SingleLinkedList", "int", size, "ParallelTransformInPlace", size, stopwatch, thread_count);
+        }
+        {
+            Stopwatch stopwatch;
+            stopwatch.Start();
+            const int64_t sum = list.Reduce(pool, int64_t{ 0 }, [](int64_t acc, int64_t value) {
+                return acc + HeavyWork(static_cast<int>(value));
+            });
+            stopwatch.Stop();
+            DoNotOptimize(sum);
+            Report("SingleLinkedList", "int", size, "ParallelReduce", size, stopwatch, thread_count);
+        }
+    }
+}
+
+// Общий стек работ: список под мьютексом, как его используют без ConcurrentSingleLinkedList
+class MutexGuardedStack {
+public:
+    void PushFront(int value) {
+        std::lock_guard guard(mutex_);
+        list_.PushFront(value);
+    }
+
+    bool TryPopFront() {
+        std::lock_guard guard(mutex_);
+        if (list_.IsEmpty()) {
+            return false;
+        }
+        list_.PopFront();
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    SingleLinkedList<int> list_;
+};
+
+class LockFreeStack {
+public:
+    void PushFront(int value) {
+        stack_.PushFront(value);
+    }
+
+    bool TryPopFront() {
+        return stack_.TryPopFront().has_value();
+    }
+
+private:
+    ConcurrentSingleLinkedList<int> stack_;
+};
+
+// Каждый поток выполняет пары PushFront/TryPopFront над общим стеком.
+// Число потоков растёт от 1 до количества аппаратных потоков
+template <typename Stack>
+void RunStackScaling(std::string_view container_name) {
+    constexpr size_t PAIRS_PER_THREAD = 200'000;
+    const size_t max_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+    std::vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    for (size_t thread_count : thread_counts) {
+        Stack stack;
+        std::atomic<bool> start{ false };
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&stack, &start] {
+                while (!start.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                size_t popped = 0;
+                for (size_t i = 0; i < PAIRS_PER_THREAD; ++i) {
+                    stack.PushFront(static_cast<int>(i));
+                    popped += stack.TryPopFront();
+                }
+                DoNotOptimize(popped);
+            });
+        }
+        Stopwatch stopwatch;
+        stopwatch.Start();
+        start.store(true, std::memory_order_release);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        stopwatch.Stop();
+        Report(container_name, "int", 0, "PushPop", 2 * PAIRS_PER_THREAD * thread_count, stopwatch, thread_count);
+    }
+}
+
+// Очередь сообщений: список под мьютексом, потребитель забирает всё накопленное обменом списков
+class MutexGuardedQueue {
+public:
+    bool TryPush(int value) {
+        std::lock_guard guard(mutex_);
+        list_.PushBack(value);
+        return true;
+    }
+
+    std::optional<int> TryPop() {
+        std::lock_guard guard(mutex_);
+        if (list_.IsEmpty()) {
+            return std::nullopt;
+        }
+        const int value = *list_.begin();
+        list_.PopFront();
+        return value;
+    }
+
+    size_t DrainInto(SingleLinkedList<int>& list) {
+        SingleLinkedList<int> taken;
+        {
+            std::lock_guard guard(mutex_);
+            taken.swap(list_);
+        }
+        const size_t count = taken.GetSize();
+        list.SpliceBack(taken);
+        return count;
+    }
+
+private:
+    std::mutex mutex_;
+    SingleLinkedList<int> list_;
+};
+
+// Число производителей растёт от 1 до количества аппаратных потоков, но не меньше 2
+std::vector<size_t> ProducerCounts() {
+    const size_t max_threads = std::max<size_t>(2, std::thread::hardware_concurrency());
+    std::vector<size_t> counts;
+    for (size_t threads = 1; threads < max_threads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(max_threads);
+    return counts;
+}
+
+// Производители передают элементы одному потребителю, который забирает их пачками через DrainInto
+template <typename Queue>
+void RunQueueThroughput(std::string_view container_name) {
+    constexpr size_t ITEMS_PER_PRODUCER = 500'000;
+    for (size_t producer_count : ProducerCounts()) {
+        Queue queue;
+        std::atomic<bool> start{ false };
+        std::vector<std::thread> producers;
+        for (size_t p = 0; p < producer_count; ++p) {
+            producers.emplace_back([&queue, &start] {
+                while (!start.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (size_t i = 0; i < ITEMS_PER_PRODUCER; ++i) {
+                    while (!queue.TryPush(static_cast<int>(i))) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        Stopwatch stopwatch;
+        stopwatch.Start();
+        start.store(true, std::memory_order_release);
+        const size_t total = ITEMS_PER_PRODUCER * producer_count;
+        size_t received = 0;
+        int64_t checksum = 0;
+        SingleLinkedList<int> batch;
+        while (received < total) {
+            if (queue.DrainInto(batch) == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (int value : batch) {
+                checksum += value;
+            }
+            received += batch.GetSize();
+            batch.Clear();
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        stopwatch.Stop();
+        DoNotOptimize(checksum);
+        Report(container_name, "int", 0, "QueueThroughput", total, stopwatch, producer_count + 1);
+    }
+}
+
+// Время передачи одного элемента: производитель ждёт, пока потребитель заберёт предыдущий
+template <typename Queue>
+void RunQueueLatency(std::string_view container_name) {
+    constexpr size_t ROUND_TRIPS = 100'000;
+    Queue queue;
+    std::atomic<size_t> consumed{ 0 };
+    std::thread consumer([&queue, &consumed] {
+        for (size_t i = 0; i < ROUND_TRIPS;) {
+            if (const auto value = queue.TryPop()) {
+                DoNotOptimize(*value);
+                consumed.store(++i, std::memory_order_release);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    Stopwatch stopwatch;
+    stopwatch.Start();
+    for (size_t i = 0; i < ROUND_TRIPS; ++i) {
+        queue.TryPush(static_cast<int>(i));
+        while (consumed.load(std::memory_order_acquire) <= i) {
+            std::this_thread::yield();
+        }
+    }
+    stopwatch.Stop();
+    consumer.join();
+    Report(container_name, "int", 0, "QueueRoundTrip", ROUND_TRIPS, stopwatch, 2);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    BenchmarkConfig config;
+    if (argc > 1) {
+        config.max_size = std::strtoull(argv[1], nullptr, 10);
+    }
+    if (argc > 2) {
+        config.filter = argv[2];
+    }
+
+    RunType<int>("int", config);
+    RunType<std::string>("std::string", config);
+    RunType<Pod256>("Pod256", config);
+
+    for (size_t size = 1000; size <= config.max_size; size *= 100) {
+        if (IsSelected(config, "SingleLinkedList", "int")) {
+            RunFragmentedScan<SingleLinkedList<int>>("SingleLinkedList", size);
+        }
+        if (IsSelected(config, "SingleLinkedList<PoolAllocator>", "int")) {
+            RunFragmentedScan<SingleLinkedList<int, PoolAllocator<int>>>("SingleLinkedList<PoolAllocator>", size);
+        }
+        if (IsSelected(config, "SingleLinkedList", "Load")) {
+            RunColdLoad<SingleLinkedList<int>>("SingleLinkedList", size);
+        }
+        if (IsSelected(config, "SingleLinkedList<PoolAllocator>", "Load")) {
+            RunColdLoad<SingleLinkedList<int, PoolAllocator<int>>>("SingleLinkedList<PoolAllocator>", size);
+        }
+    }
+    for (size_t size = 1000; size <= config.max_size; size *= 100) {
+        if (IsSelected(config, "SingleLinkedList", "uint32_t")) {
+            RunLargeList<SingleLinkedList<uint32_t>>("SingleLinkedList", size);
+        }
+        if (IsSelected(config, "CompactSingleLinkedList", "uint32_t")) {
+            RunLargeList<CompactSingleLinkedList<uint32_t>>("CompactSingleLinkedList", size);
+        }
+    }
+    if (IsSelected(config, "SingleLinkedList", "int")) {
+        RunSmallLists<SingleLinkedList<int>>("SingleLinkedList");
+    }
+    if (IsSelected(config, "SmallSingleLinkedList<4>", "int")) {
+        RunSmallLists<SmallSingleLinkedList<int, 4>>("SmallSingleLinkedList<4>");
+    }
+    for (size_t size = 1000; size <= std::min<size_t>(config.max_size, 1'000'000); size *= 10) {
+        if (IsSelected(config, "IndexedSingleLinkedList", "Ordered")) {
+            RunOrderedInsert(size);
+        }
+        if (IsSelected(config, "IntrusiveSingleLinkedList", "OwnedObject")) {
+            RunIntrusive(size);
+        }
+        if (IsSelected(config, "LazyView", "Pipeline")) {
+            RunPipeline(size);
+        }
+        if (IsSelected(config, "HashIndexedSingleLinkedList", "Session")) {
+            RunSessionLookup(size);
+        }
+        if (IsSelected(config, "SingleLinkedList", "Snapshot")) {
+            RunSnapshots<SingleLinkedList<int>>("SingleLinkedList", size);
+        }
+        if (IsSelected(config, "PersistentSingleLinkedList", "Snapshot")) {
+            RunSnapshots<PersistentSingleLinkedList<int>>("PersistentSingleLinkedList", size);
+        }
+    }
+    if (IsSelected(config, "SingleLinkedList", "Parallel")) {
+        RunParallelScaling(std::min<size_t>(config.max_size, 1'000'000));
+    }
+    if (IsSelected(config, "ConcurrentSingleLinkedList", "int")) {
+        RunStackScaling<LockFreeStack>("ConcurrentSingleLinkedList");
+    }
+    if (IsSelected(config, "SingleLinkedList+std::mutex", "int")) {
+        RunStackScaling<MutexGuardedStack>("SingleLinkedList+std::mutex");
+    }
+    if (IsSelected(config, "MpscQueue", "Queue")) {
+        RunQueueThroughput<MpscQueue<int>>("MpscQueue");
+        RunQueueLatency<MpscQueue<int>>("MpscQueue");
+    }
+    if (IsSelected(config, "SingleLinkedList+std::mutex", "Queue")) {
+        RunQueueThroughput<MutexGuardedQueue>("SingleLinkedList+std::mutex");
+        RunQueueLatency<MutexGuardedQueue>("SingleLinkedList+std::mutex");
+    }
+}
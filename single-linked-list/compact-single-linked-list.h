@@ -0,0 +1,521 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "single-linked-list.h"
+
+/*
+ * Односвязный список с компактными узлами для очень длинных списков.
+ * Узлы хранятся в участках по CHUNK_SIZE штук, связь узла - 32-битный номер следующего узла,
+ * а не указатель. Номера и значения лежат в участке двумя отдельными массивами, поэтому
+ * на узел сверх значения приходится ровно 4 байта, без выравнивания и заголовков malloc.
+ * Итераторы, InsertAfter, EraseAfter и остальные операции ведут себя так же, как у SingleLinkedList:
+ * вставка не делает недействительными итераторы, удаление - только итераторы на удалённый элемент.
+ * Освобождённые узлы переиспользуются, память участков возвращается только в Clear и деструкторе.
+ * Список вмещает не больше 2^32 - 2 элементов
+ */
+template <typename Type, typename Allocator = std::allocator<Type>>
+class CompactSingleLinkedList {
+    using Index = uint32_t;
+
+    // Номер, которым обозначается отсутствие следующего узла
+    static constexpr Index NIL = UINT32_MAX;
+    // Номер фиктивного узла перед первым элементом. Его связь хранится в Pool::head
+    static constexpr Index HEAD = UINT32_MAX - 1;
+    static constexpr Index CHUNK_SHIFT = 12;
+    static constexpr Index CHUNK_SIZE = Index{ 1 } << CHUNK_SHIFT;
+    static constexpr Index CHUNK_MASK = CHUNK_SIZE - 1;
+
+    // Участок узлов: связи и значения хранятся отдельными массивами
+    struct Chunk {
+        Index next[CHUNK_SIZE];
+        alignas(Type) unsigned char values[CHUNK_SIZE * sizeof(Type)];
+    };
+
+    using ChunkAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Chunk>;
+    using ChunkTraits = std::allocator_traits<ChunkAllocator>;
+
+    // Участки списка. Итераторы указывают на Pool, поэтому остаются действительными при обмене и перемещении списков
+    struct Pool {
+        // Связь узла с номером index, для HEAD - связь фиктивного узла
+        [[nodiscard]] Index& LinkOf(Index index) noexcept {
+            return index == HEAD ? head : chunks[index >> CHUNK_SHIFT]->next[index & CHUNK_MASK];
+        }
+
+        [[nodiscard]] void* StorageOf(Index index) noexcept {
+            return chunks[index >> CHUNK_SHIFT]->values + static_cast<size_t>(index & CHUNK_MASK) * sizeof(Type);
+        }
+
+        [[nodiscard]] Type& ValueOf(Index index) noexcept {
+            return *std::launder(static_cast<Type*>(StorageOf(index)));
+        }
+
+        std::vector<Chunk*> chunks;
+        Index head = NIL;
+    };
+
+    // Аллокатор участков хранится как база, чтобы аллокатор без состояния не занимал места.
+    // Pool создаётся вместе со списком: итераторы, полученные до первой вставки, указывают на него
+    struct Storage : ChunkAllocator {
+        Storage() = default;
+
+        explicit Storage(const ChunkAllocator& alloc) noexcept
+            : ChunkAllocator(alloc) {
+        }
+
+        std::unique_ptr<Pool> pool = std::make_unique<Pool>();
+    };
+
+    template <typename ValueType>
+    class BasicIterator {
+        friend class CompactSingleLinkedList;
+
+        BasicIterator(Pool* pool, Index index) noexcept
+            : pool_(pool)
+            , index_(index) {
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueType*;
+        using reference = ValueType&;
+
+        BasicIterator() = default;
+
+        // При ValueType, совпадающем с Type, играет роль копирующего конструктора,
+        // при const Type - конвертирующего
+        BasicIterator(const BasicIterator<Type>& other) noexcept
+            : pool_(other.pool_)
+            , index_(other.index_) {
+        }
+
+        BasicIterator& operator=(const BasicIterator& rhs) = default;
+
+        // Как и у SingleLinkedList, сравниваются только позиции: end() любого списка равен end() другого
+        [[nodiscard]] bool operator==(const BasicIterator<const Type>& rhs) const noexcept {
+            return index_ == rhs.index_;
+        }
+
+        [[nodiscard]] bool operator!=(const BasicIterator<const Type>& rhs) const noexcept {
+            return index_ != rhs.index_;
+        }
+
+        [[nodiscard]] bool operator==(const BasicIterator<Type>& rhs) const noexcept {
+            return index_ == rhs.index_;
+        }
+
+        [[nodiscard]] bool operator!=(const BasicIterator<Type>& rhs) const noexcept {
+            return index_ != rhs.index_;
+        }
+
+        BasicIterator& operator++() noexcept {
+            assert(index_ != NIL);
+            index_ = pool_->LinkOf(index_);
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            auto old_value(*this);
+            ++*this;
+            return old_value;
+        }
+
+        [[nodiscard]] reference operator*() const noexcept {
+            assert(index_ != NIL && index_ != HEAD);
+            return pool_->ValueOf(index_);
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept {
+            assert(index_ != NIL && index_ != HEAD);
+            return &pool_->ValueOf(index_);
+        }
+
+    private:
+        Pool* pool_ = nullptr;
+        Index index_ = NIL;
+    };
+
+public:
+    using value_type = Type;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using allocator_type = Allocator;
+
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+
+    // Сколько байт занимает узел вместе со связью
+    static constexpr size_t BYTES_PER_NODE = sizeof(Chunk) / CHUNK_SIZE;
+    // Наибольшее число элементов списка
+    static constexpr size_t MAX_SIZE = HEAD;
+
+    CompactSingleLinkedList() = default;
+
+    explicit CompactSingleLinkedList(const Allocator& alloc)
+        : storage_(ChunkAllocator(alloc)) {
+    }
+
+    CompactSingleLinkedList(std::initializer_list<Type> i_list, const Allocator& alloc = Allocator())
+        : CompactSingleLinkedList(i_list.begin(), i_list.end(), alloc) {
+    }
+
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    CompactSingleLinkedList(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+        : storage_(ChunkAllocator(alloc)) {
+        try {
+            if constexpr (detail::IS_FORWARD_ITERATOR<InputIt>) {
+                Reserve(static_cast<size_t>(std::distance(first, last)));
+            }
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+        } catch (...) {
+            Clear();
+            throw;
+        }
+    }
+
+    // Копия строится заново, поэтому её узлы лежат подряд в порядке списка
+    CompactSingleLinkedList(const CompactSingleLinkedList& other)
+        : CompactSingleLinkedList(other.begin(), other.end(),
+                                  Allocator(ChunkTraits::select_on_container_copy_construction(other.Alloc()))) {
+    }
+
+    // Участки переходят к новому списку вместе с Pool, итераторы other остаются действительными.
+    // other получает новый пустой Pool, поэтому перемещение выделяет память и может выбросить bad_alloc
+    CompactSingleLinkedList(CompactSingleLinkedList&& other)
+        : storage_(other.Alloc())
+        , tail_(std::exchange(other.tail_, HEAD))
+        , free_(std::exchange(other.free_, NIL))
+        , used_(std::exchange(other.used_, 0))
+        , size_(std::exchange(other.size_, 0)) {
+        storage_.pool.swap(other.storage_.pool);
+    }
+
+    CompactSingleLinkedList& operator=(const CompactSingleLinkedList& rhs) {
+        if (this != &rhs) {
+            CompactSingleLinkedList copy(rhs);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    CompactSingleLinkedList& operator=(CompactSingleLinkedList&& rhs) {
+        if (this != &rhs) {
+            CompactSingleLinkedList moved(std::move(rhs));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    ~CompactSingleLinkedList() {
+        Clear();
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Число узлов, под которые уже выделена память
+    [[nodiscard]] size_t GetCapacity() const noexcept {
+        return storage_.pool->chunks.size() * CHUNK_SIZE;
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept {
+        return allocator_type(Alloc());
+    }
+
+    // Выделяет участки заранее, чтобы в списке поместилось capacity элементов
+    void Reserve(size_t capacity) {
+        if (capacity > MAX_SIZE) {
+            throw std::length_error("CompactSingleLinkedList: too many elements");
+        }
+        Pool& pool = GetPool();
+        const size_t chunks = (capacity + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        pool.chunks.reserve(chunks);
+        while (pool.chunks.size() < chunks) {
+            AddChunk(pool);
+        }
+    }
+
+    [[nodiscard]] Type& front() noexcept {
+        assert(!IsEmpty());
+        return storage_.pool->ValueOf(storage_.pool->head);
+    }
+
+    [[nodiscard]] const Type& front() const noexcept {
+        assert(!IsEmpty());
+        return storage_.pool->ValueOf(storage_.pool->head);
+    }
+
+    [[nodiscard]] Type& back() noexcept {
+        assert(!IsEmpty());
+        return storage_.pool->ValueOf(tail_);
+    }
+
+    [[nodiscard]] const Type& back() const noexcept {
+        assert(!IsEmpty());
+        return storage_.pool->ValueOf(tail_);
+    }
+
+    void PushFront(const Type& value) {
+        EmplaceAfter(cbefore_begin(), value);
+    }
+
+    void PushFront(Type&& value) {
+        EmplaceAfter(cbefore_begin(), std::move(value));
+    }
+
+    template <typename... Args>
+    Type& EmplaceFront(Args&&... args) {
+        return *EmplaceAfter(cbefore_begin(), std::forward<Args>(args)...);
+    }
+
+    void PushBack(const Type& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(Type&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return *EmplaceAfter(ConstIterator{ nullptr, tail_ }, std::forward<Args>(args)...);
+    }
+
+    /*
+     * Вставляет элемент value после элемента, на который указывает pos.
+     * Возвращает итератор на вставленный элемент.
+     * Если при создании элемента будет выброшено исключение, список останется в прежнем состоянии
+     */
+    Iterator InsertAfter(ConstIterator pos, const Type& value) {
+        return EmplaceAfter(pos, value);
+    }
+
+    Iterator InsertAfter(ConstIterator pos, Type&& value) {
+        return EmplaceAfter(pos, std::move(value));
+    }
+
+    template <typename... Args>
+    Iterator EmplaceAfter(ConstIterator pos, Args&&... args) {
+        Pool& pool = GetPool();
+        const Index node = AcquireNode(pool);
+        try {
+            ::new (pool.StorageOf(node)) Type(std::forward<Args>(args)...);
+        } catch (...) {
+            ReleaseNode(pool, node);
+            throw;
+        }
+        Index& link = pool.LinkOf(pos.index_);
+        pool.LinkOf(node) = link;
+        link = node;
+        if (pos.index_ == tail_) {
+            tail_ = node;
+        }
+        ++size_;
+        return Iterator{ &pool, node };
+    }
+
+    void PopFront() noexcept {
+        assert(!IsEmpty());
+        EraseAfter(cbefore_begin());
+    }
+
+    /*
+     * Удаляет элемент, следующий за pos.
+     * Возвращает итератор на элемент, следующий за удалённым
+     */
+    Iterator EraseAfter(ConstIterator pos) noexcept {
+        Pool& pool = *storage_.pool;
+        Index& link = pool.LinkOf(pos.index_);
+        assert(link != NIL);
+        const Index erased = link;
+        link = pool.LinkOf(erased);
+        if (erased == tail_) {
+            tail_ = pos.index_;
+        }
+        std::destroy_at(&pool.ValueOf(erased));
+        ReleaseNode(pool, erased);
+        --size_;
+        return Iterator{ &pool, link };
+    }
+
+    // Разрушает элементы и освобождает память всех участков
+    void Clear() noexcept {
+        Pool& pool = *storage_.pool;
+        if constexpr (!std::is_trivially_destructible_v<Type>) {
+            for (Index node = pool.head; node != NIL; node = pool.LinkOf(node)) {
+                std::destroy_at(&pool.ValueOf(node));
+            }
+        }
+        for (Chunk* chunk : pool.chunks) {
+            ChunkTraits::deallocate(Alloc(), chunk, 1);
+        }
+        pool.chunks.clear();
+        pool.head = NIL;
+        tail_ = HEAD;
+        free_ = NIL;
+        used_ = 0;
+        size_ = 0;
+    }
+
+    void swap(CompactSingleLinkedList& other) noexcept {
+        using std::swap;
+        swap(Alloc(), other.Alloc());
+        swap(storage_.pool, other.storage_.pool);
+        swap(tail_, other.tail_);
+        swap(free_, other.free_);
+        swap(used_, other.used_);
+        swap(size_, other.size_);
+    }
+
+    [[nodiscard]] Iterator begin() noexcept {
+        return Iterator{ storage_.pool.get(), storage_.pool->head };
+    }
+
+    [[nodiscard]] Iterator end() noexcept {
+        return Iterator{ storage_.pool.get(), NIL };
+    }
+
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        return cbegin();
+    }
+
+    [[nodiscard]] ConstIterator end() const noexcept {
+        return cend();
+    }
+
+    [[nodiscard]] ConstIterator cbegin() const noexcept {
+        return const_cast<CompactSingleLinkedList&>(*this).begin();
+    }
+
+    [[nodiscard]] ConstIterator cend() const noexcept {
+        return const_cast<CompactSingleLinkedList&>(*this).end();
+    }
+
+    // Итератор на позицию перед первым элементом. Разыменовывать его нельзя
+    [[nodiscard]] Iterator before_begin() noexcept {
+        return Iterator{ storage_.pool.get(), HEAD };
+    }
+
+    [[nodiscard]] ConstIterator cbefore_begin() const noexcept {
+        return const_cast<CompactSingleLinkedList&>(*this).before_begin();
+    }
+
+    [[nodiscard]] ConstIterator before_begin() const noexcept {
+        return cbefore_begin();
+    }
+
+private:
+    [[nodiscard]] ChunkAllocator& Alloc() noexcept {
+        return storage_;
+    }
+
+    [[nodiscard]] const ChunkAllocator& Alloc() const noexcept {
+        return storage_;
+    }
+
+    [[nodiscard]] Pool& GetPool() noexcept {
+        return *storage_.pool;
+    }
+
+    void AddChunk(Pool& pool) {
+        pool.chunks.push_back(nullptr);
+        try {
+            pool.chunks.back() = ChunkTraits::allocate(Alloc(), 1);
+        } catch (...) {
+            pool.chunks.pop_back();
+            throw;
+        }
+    }
+
+    // Берёт узел из списка свободных, затем из ещё не использованной части участков
+    [[nodiscard]] Index AcquireNode(Pool& pool) {
+        if (free_ != NIL) {
+            const Index node = free_;
+            free_ = pool.LinkOf(node);
+            return node;
+        }
+        if (used_ == MAX_SIZE) {
+            throw std::length_error("CompactSingleLinkedList: too many elements");
+        }
+        if (used_ == pool.chunks.size() * CHUNK_SIZE) {
+            AddChunk(pool);
+        }
+        return used_++;
+    }
+
+    // Свободные узлы связываются через те же номера, что и элементы списка
+    void ReleaseNode(Pool& pool, Index node) noexcept {
+        pool.LinkOf(node) = free_;
+        free_ = node;
+    }
+
+    Storage storage_;
+    // Последний узел, у пустого списка - HEAD
+    Index tail_ = HEAD;
+    // Первый свободный узел
+    Index free_ = NIL;
+    // Сколько узлов участков уже выдавалось
+    Index used_ = 0;
+    size_t size_ = 0;
+};
+
+template <typename Type, typename Allocator>
+void swap(CompactSingleLinkedList<Type, Allocator>& lhs, CompactSingleLinkedList<Type, Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename Type, typename Allocator>
+[[nodiscard]] bool operator==(const CompactSingleLinkedList<Type, Allocator>& lhs,
+                              const CompactSingleLinkedList<Type, Allocator>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, typename Allocator>
+[[nodiscard]] bool operator!=(const CompactSingleLinkedList<Type, Allocator>& lhs,
+                              const CompactSingleLinkedList<Type, Allocator>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Allocator>
+[[nodiscard]] bool operator<(const CompactSingleLinkedList<Type, Allocator>& lhs,
+                             const CompactSingleLinkedList<Type, Allocator>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, typename Allocator>
+[[nodiscard]] bool operator<=(const CompactSingleLinkedList<Type, Allocator>& lhs,
+                              const CompactSingleLinkedList<Type, Allocator>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename Allocator>
+[[nodiscard]] bool operator>(const CompactSingleLinkedList<Type, Allocator>& lhs,
+                             const CompactSingleLinkedList<Type, Allocator>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename Allocator>
+[[nodiscard]] bool operator>=(const CompactSingleLinkedList<Type, Allocator>& lhs,
+                              const CompactSingleLinkedList<Type, Allocator>& rhs) {
+    return !(lhs < rhs);
+}
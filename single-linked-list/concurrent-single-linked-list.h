@@ -0,0 +1,210 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Потокобезопасный односвязный список для работы в режиме стека (стек Трайбера).
+// PushFront и PopFront из разных потоков не требуют блокировок: вершина меняется через CAS.
+// Узлы адресуются 32-битными индексами, а вершина хранит пару (метка, индекс) в одном
+// 64-битном атомарном слове. Метка увеличивается при каждой смене вершины, поэтому CAS
+// с устаревшим значением не проходит, даже если тот же узел успел вернуться на вершину (проблема ABA).
+// Извлечённые узлы попадают в собственный список свободных узлов и переиспользуются,
+// память узлов освобождается только в деструкторе, поэтому чтение next_node
+// у уже извлечённого другим потоком узла безопасно
+template <typename Type>
+class ConcurrentSingleLinkedList {
+    struct Node {
+        std::atomic<uint32_t> next_node{ NULL_INDEX };
+        alignas(Type) unsigned char storage[sizeof(Type)];
+
+        [[nodiscard]] Type* Value() noexcept {
+            return std::launder(reinterpret_cast<Type*>(storage));
+        }
+    };
+
+public:
+    ConcurrentSingleLinkedList() = default;
+    ConcurrentSingleLinkedList(const ConcurrentSingleLinkedList&) = delete;
+    ConcurrentSingleLinkedList& operator=(const ConcurrentSingleLinkedList&) = delete;
+
+    ~ConcurrentSingleLinkedList() {
+        uint32_t index = IndexOf(head_.load(std::memory_order_acquire));
+        while (index != NULL_INDEX) {
+            Node& node = NodeAt(index);
+            std::destroy_at(node.Value());
+            index = node.next_node.load(std::memory_order_relaxed);
+        }
+        for (auto& segment : segments_) {
+            delete[] segment.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Примерное количество элементов. При одновременных вставках и удалениях
+    // значение может отставать от фактического
+    [[nodiscard]] size_t GetSize() const noexcept {
+        const std::ptrdiff_t size = size_.load(std::memory_order_relaxed);
+        return size > 0 ? static_cast<size_t>(size) : 0;
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return IndexOf(head_.load(std::memory_order_acquire)) == NULL_INDEX;
+    }
+
+    void PushFront(const Type& value) {
+        EmplaceFront(value);
+    }
+
+    void PushFront(Type&& value) {
+        EmplaceFront(std::move(value));
+    }
+
+    // Конструирует элемент из args и помещает его на вершину
+    // Если конструктор Type выбросит исключение, список не изменится
+    template <typename... Args>
+    void EmplaceFront(Args&&... args) {
+        const uint32_t index = AcquireNode();
+        Node& node = NodeAt(index);
+        try {
+            ::new (static_cast<void*>(node.storage)) Type(std::forward<Args>(args)...);
+        } catch (...) {
+            PushIndex(free_head_, index);
+            throw;
+        }
+        PushIndex(head_, index);
+        size_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Извлекает элемент с вершины. Возвращает std::nullopt, если список пуст.
+    // Узел снимается с вершины до того, как из него забирается значение, и вернуть его обратно
+    // уже нельзя, поэтому перемещение Type не должно выбрасывать исключений
+    [[nodiscard]] std::optional<Type> TryPopFront() {
+        static_assert(std::is_nothrow_move_constructible_v<Type>,
+                      "TryPopFront requires a nothrow move constructor, otherwise a popped element could be lost");
+        const uint32_t index = PopIndex(head_);
+        if (index == NULL_INDEX) {
+            return std::nullopt;
+        }
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        Node& node = NodeAt(index);
+        std::optional<Type> result(std::move(*node.Value()));
+        std::destroy_at(node.Value());
+        PushIndex(free_head_, index);
+        return result;
+    }
+
+    // Удаляет элемент с вершины, если список не пуст
+    void PopFront() noexcept {
+        const uint32_t index = PopIndex(head_);
+        if (index == NULL_INDEX) {
+            return;
+        }
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        Node& node = NodeAt(index);
+        std::destroy_at(node.Value());
+        PushIndex(free_head_, index);
+    }
+
+private:
+    static constexpr uint32_t NULL_INDEX = 0;
+    // Первый сегмент содержит 2^FIRST_SEGMENT_BITS узлов, каждый следующий - вдвое больше
+    static constexpr unsigned FIRST_SEGMENT_BITS = 6;
+    static constexpr size_t MAX_SEGMENTS = 32 - FIRST_SEGMENT_BITS;
+    static constexpr uint64_t MAX_INDEX = ((uint64_t{ 1 } << MAX_SEGMENTS) - 1) << FIRST_SEGMENT_BITS;
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Нужен атомарный 64-битный CAS");
+
+    [[nodiscard]] static uint32_t IndexOf(uint64_t tagged) noexcept {
+        return static_cast<uint32_t>(tagged);
+    }
+
+    [[nodiscard]] static uint64_t MakeTagged(uint64_t old_tagged, uint32_t index) noexcept {
+        return ((old_tagged >> 32) + 1) << 32 | index;
+    }
+
+    [[nodiscard]] static unsigned Log2(uint64_t value) noexcept {
+        unsigned result = 0;
+        while (value >>= 1) {
+            ++result;
+        }
+        return result;
+    }
+
+    // Индекс i (начиная с 1) лежит в сегменте k, покрывающем позиции
+    // [2^B * (2^k - 1), 2^B * (2^(k+1) - 1)), где B = FIRST_SEGMENT_BITS
+    [[nodiscard]] static size_t SegmentOf(uint64_t position) noexcept {
+        return Log2((position >> FIRST_SEGMENT_BITS) + 1);
+    }
+
+    [[nodiscard]] static uint64_t SegmentStart(size_t segment) noexcept {
+        return ((uint64_t{ 1 } << segment) - 1) << FIRST_SEGMENT_BITS;
+    }
+
+    [[nodiscard]] Node& NodeAt(uint32_t index) const noexcept {
+        assert(index != NULL_INDEX);
+        const uint64_t position = index - 1;
+        const size_t segment = SegmentOf(position);
+        return segments_[segment].load(std::memory_order_acquire)[position - SegmentStart(segment)];
+    }
+
+    // Берёт узел из списка свободных либо выделяет новый индекс
+    uint32_t AcquireNode() {
+        const uint32_t recycled = PopIndex(free_head_);
+        if (recycled != NULL_INDEX) {
+            return recycled;
+        }
+        const uint64_t position = next_unused_.fetch_add(1, std::memory_order_relaxed);
+        if (position >= MAX_INDEX) {
+            throw std::length_error("ConcurrentSingleLinkedList: too many nodes");
+        }
+        EnsureSegment(SegmentOf(position));
+        return static_cast<uint32_t>(position + 1);
+    }
+
+    // Сегмент выделяет тот поток, который первым к нему обратился, остальные используют его сегмент
+    void EnsureSegment(size_t segment) {
+        if (segments_[segment].load(std::memory_order_acquire) != nullptr) {
+            return;
+        }
+        Node* fresh = new Node[size_t{ 1 } << (segment + FIRST_SEGMENT_BITS)];
+        Node* expected = nullptr;
+        if (!segments_[segment].compare_exchange_strong(expected, fresh, std::memory_order_acq_rel)) {
+            delete[] fresh;
+        }
+    }
+
+    void PushIndex(std::atomic<uint64_t>& top, uint32_t index) noexcept {
+        Node& node = NodeAt(index);
+        uint64_t old_top = top.load(std::memory_order_relaxed);
+        do {
+            node.next_node.store(IndexOf(old_top), std::memory_order_relaxed);
+        } while (!top.compare_exchange_weak(old_top, MakeTagged(old_top, index),
+                                            std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    uint32_t PopIndex(std::atomic<uint64_t>& top) noexcept {
+        uint64_t old_top = top.load(std::memory_order_acquire);
+        while (IndexOf(old_top) != NULL_INDEX) {
+            const uint32_t next = NodeAt(IndexOf(old_top)).next_node.load(std::memory_order_relaxed);
+            if (top.compare_exchange_weak(old_top, MakeTagged(old_top, next),
+                                          std::memory_order_acquire, std::memory_order_acquire)) {
+                return IndexOf(old_top);
+            }
+        }
+        return NULL_INDEX;
+    }
+
+    // Вершина стека элементов и вершина стека свободных узлов: (метка << 32) | индекс
+    alignas(64) std::atomic<uint64_t> head_{ NULL_INDEX };
+    alignas(64) std::atomic<uint64_t> free_head_{ NULL_INDEX };
+    alignas(64) std::atomic<std::ptrdiff_t> size_{ 0 };
+    std::atomic<uint64_t> next_unused_{ 0 };
+    std::atomic<Node*> segments_[MAX_SEGMENTS] = {};
+};
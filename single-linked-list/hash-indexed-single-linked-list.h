@@ -0,0 +1,292 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include "single-linked-list.h"
+
+// Односвязный список с хеш-индексом для поиска и удаления по значению за время O(1).
+// Индекс сопоставляет каждому элементу итератор на предшествующий ему узел, поэтому
+// найденный элемент удаляется через EraseAfter без обхода списка.
+// PushFront, InsertAfter, EraseAfter, PopFront и Clear поддерживают индекс.
+// Элементы доступны только для чтения: изменение значения разошлось бы с индексом.
+// Равные элементы допускаются, Find возвращает один из них
+template <typename Type, typename Hash = std::hash<Type>, typename KeyEqual = std::equal_to<Type>,
+          typename Allocator = std::allocator<Type>>
+class HashIndexedSingleLinkedList {
+    using List = SingleLinkedList<Type, Allocator>;
+
+public:
+    using Iterator = typename List::ConstIterator;
+    using ConstIterator = typename List::ConstIterator;
+    using value_type = Type;
+    using reference = const value_type&;
+    using const_reference = const value_type&;
+
+    HashIndexedSingleLinkedList() = default;
+
+    HashIndexedSingleLinkedList(std::initializer_list<Type> values)
+        : list_(values) {
+        Rebuild();
+    }
+
+    // Строит индекс над узлами list. Узлы не копируются
+    explicit HashIndexedSingleLinkedList(List&& list)
+        : list_(std::move(list)) {
+        Rebuild();
+    }
+
+    HashIndexedSingleLinkedList(const HashIndexedSingleLinkedList& other)
+        : list_(other.list_) {
+        Rebuild();
+    }
+
+    // Перемещение сохраняет узлы, поэтому индекс переносится вместе с ними
+    HashIndexedSingleLinkedList(HashIndexedSingleLinkedList&& other) noexcept {
+        swap(other);
+    }
+
+    HashIndexedSingleLinkedList& operator=(const HashIndexedSingleLinkedList& rhs) {
+        if (this != &rhs) {
+            HashIndexedSingleLinkedList copy(rhs);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    HashIndexedSingleLinkedList& operator=(HashIndexedSingleLinkedList&& rhs) noexcept {
+        if (this != &rhs) {
+            HashIndexedSingleLinkedList moved(std::move(rhs));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    void swap(HashIndexedSingleLinkedList& other) noexcept {
+        list_.swap(other.list_);
+        index_.swap(other.index_);
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return list_.GetSize();
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return list_.IsEmpty();
+    }
+
+    // Список без индекса, например для сравнения или сериализации
+    [[nodiscard]] const List& GetList() const noexcept {
+        return list_;
+    }
+
+    // Забирает узлы в обычный список, индекс становится пустым
+    [[nodiscard]] List Release() noexcept {
+        List list(std::move(list_));
+        index_.clear();
+        return list;
+    }
+
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        return list_.begin();
+    }
+
+    [[nodiscard]] ConstIterator end() const noexcept {
+        return list_.end();
+    }
+
+    [[nodiscard]] ConstIterator cbegin() const noexcept {
+        return list_.cbegin();
+    }
+
+    [[nodiscard]] ConstIterator cend() const noexcept {
+        return list_.cend();
+    }
+
+    [[nodiscard]] ConstIterator before_begin() const noexcept {
+        return list_.cbefore_begin();
+    }
+
+    [[nodiscard]] ConstIterator cbefore_begin() const noexcept {
+        return list_.cbefore_begin();
+    }
+
+    // Возвращает итератор на элемент, равный value, либо end(). Время работы O(1) в среднем
+    [[nodiscard]] ConstIterator Find(const Type& value) const {
+        const auto found = index_.find(&value);
+        return found == index_.end() ? cend() : std::next(PredecessorOf(found));
+    }
+
+    // Возвращает итератор на элемент перед найденным Find(value), либо end(), если value нет.
+    // Его можно передать в EraseAfter
+    [[nodiscard]] ConstIterator FindBefore(const Type& value) const {
+        const auto found = index_.find(&value);
+        return found == index_.end() ? cend() : PredecessorOf(found);
+    }
+
+    [[nodiscard]] bool Contains(const Type& value) const {
+        return index_.find(&value) != index_.end();
+    }
+
+    [[nodiscard]] size_t Count(const Type& value) const {
+        return index_.count(&value);
+    }
+
+    void PushFront(const Type& value) {
+        Insert(cbefore_begin(), value);
+    }
+
+    void PushFront(Type&& value) {
+        Insert(cbefore_begin(), std::move(value));
+    }
+
+    template <typename... Args>
+    ConstIterator EmplaceFront(Args&&... args) {
+        return Insert(cbefore_begin(), std::forward<Args>(args)...);
+    }
+
+    // Вставляет value после pos. Время работы O(1) в среднем
+    ConstIterator InsertAfter(ConstIterator pos, const Type& value) {
+        return Insert(pos, value);
+    }
+
+    ConstIterator InsertAfter(ConstIterator pos, Type&& value) {
+        return Insert(pos, std::move(value));
+    }
+
+    template <typename... Args>
+    ConstIterator EmplaceAfter(ConstIterator pos, Args&&... args) {
+        return Insert(pos, std::forward<Args>(args)...);
+    }
+
+    void PopFront() {
+        assert(!IsEmpty());
+        EraseAfter(cbefore_begin());
+    }
+
+    // Удаляет элемент, следующий за pos. Возвращает итератор на элемент, следующий за удалённым
+    ConstIterator EraseAfter(ConstIterator pos) {
+        assert(std::next(pos) != cend());
+        return Erase(EntryOf(std::addressof(*std::next(pos))));
+    }
+
+    // Удаляет все элементы, равные value, и возвращает их количество.
+    // Каждое удаление занимает O(1) в среднем, обход списка не нужен
+    size_t EraseValue(const Type& value) {
+        auto [it, last] = index_.equal_range(&value);
+        size_t erased = 0;
+        // value может быть ссылкой на элемент этого же списка, такой элемент удаляется последним
+        bool erase_self = false;
+        while (it != last) {
+            const auto current = it++;
+            if (current->first == &value) {
+                erase_self = true;
+                continue;
+            }
+            Erase(current);
+            ++erased;
+        }
+        if (erase_self) {
+            Erase(EntryOf(&value));
+            ++erased;
+        }
+        return erased;
+    }
+
+    void Clear() noexcept {
+        list_.Clear();
+        index_.clear();
+    }
+
+private:
+    // Хеш и сравнение элементов по их адресам: ключ индекса - адрес элемента в узле,
+    // а поиск по значению передаёт адрес искомого значения
+    struct HashByValue {
+        size_t operator()(const Type* value) const {
+            return Hash{}(*value);
+        }
+    };
+
+    struct EqualByValue {
+        bool operator()(const Type* lhs, const Type* rhs) const {
+            return KeyEqual{}(*lhs, *rhs);
+        }
+    };
+
+    using Index = std::unordered_multimap<const Type*, ConstIterator, HashByValue, EqualByValue>;
+
+    // Фиктивный узел принадлежит объекту list_, а не цепочке узлов, и при обмене или перемещении
+    // списка остаётся на месте. Поэтому для первого элемента вместо before_begin хранится end()
+    [[nodiscard]] ConstIterator Stored(ConstIterator predecessor) const noexcept {
+        return predecessor == cbefore_begin() ? cend() : predecessor;
+    }
+
+    [[nodiscard]] ConstIterator PredecessorOf(typename Index::const_iterator entry) const noexcept {
+        return entry->second == cend() ? cbefore_begin() : entry->second;
+    }
+
+    // Запись индекса для элемента, лежащего по адресу element. Равные элементы различаются по адресу,
+    // поэтому перебираются только записи с тем же значением
+    [[nodiscard]] typename Index::iterator EntryOf(const Type* element) {
+        auto [it, last] = index_.equal_range(element);
+        while (it->first != element) {
+            ++it;
+            assert(it != last);
+        }
+        return it;
+    }
+
+    template <typename... Args>
+    ConstIterator Insert(ConstIterator pos, Args&&... args) {
+        const ConstIterator next = std::next(pos);
+        const ConstIterator inserted = list_.EmplaceAfter(pos, std::forward<Args>(args)...);
+        try {
+            index_.emplace(std::addressof(*inserted), Stored(pos));
+        } catch (...) {
+            list_.EraseAfter(pos);
+            throw;
+        }
+        // Предшественником следующего элемента теперь стал вставленный
+        if (next != cend()) {
+            EntryOf(std::addressof(*next))->second = inserted;
+        }
+        return inserted;
+    }
+
+    // Удаляет элемент, которому соответствует запись индекса entry
+    ConstIterator Erase(typename Index::iterator entry) {
+        const ConstIterator pos = PredecessorOf(entry);
+        const ConstIterator after = std::next(pos, 2);
+        if (after != cend()) {
+            EntryOf(std::addressof(*after))->second = Stored(pos);
+        }
+        index_.erase(entry);
+        return list_.EraseAfter(pos);
+    }
+
+    // Строит индекс за один проход по списку
+    void Rebuild() {
+        index_.clear();
+        index_.reserve(GetSize());
+        ConstIterator prev = cbefore_begin();
+        for (ConstIterator it = cbegin(); it != cend(); prev = it++) {
+            index_.emplace(std::addressof(*it), Stored(prev));
+        }
+    }
+
+    List list_;
+    // Адрес элемента -> итератор на предшествующий ему узел, для первого элемента - end()
+    Index index_;
+};
+
+template <typename Type, typename Hash, typename KeyEqual, typename Allocator>
+void swap(HashIndexedSingleLinkedList<Type, Hash, KeyEqual, Allocator>& lhs,
+          HashIndexedSingleLinkedList<Type, Hash, KeyEqual, Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
@@ -0,0 +1,412 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "single-linked-list.h"
+
+// Односвязный список с разреженным индексом для доступа по номеру за время O(√N).
+// Цепочка узлов делится на участки длиной порядка √N элементов, для каждого участка хранятся
+// итератор на его первый элемент и длина. At, IteratorAt и LowerBound сначала находят
+// нужный участок по индексу, а затем проходят не больше двух длин участка.
+// PushFront, InsertAfter и EraseAfter поддерживают индекс: ищут участок позиции,
+// проходя вперёд до начала следующего участка, и делят или объединяют участки,
+// когда длина выходит за допустимые границы. Итераторы остаются действительными так же, как у SingleLinkedList
+template <typename Type, typename Allocator = std::allocator<Type>>
+class IndexedSingleLinkedList {
+    using List = SingleLinkedList<Type, Allocator>;
+
+public:
+    using Iterator = typename List::Iterator;
+    using ConstIterator = typename List::ConstIterator;
+    using value_type = Type;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    IndexedSingleLinkedList() = default;
+
+    IndexedSingleLinkedList(std::initializer_list<Type> values)
+        : list_(values) {
+        Rebuild();
+    }
+
+    // Строит индекс над узлами list. Узлы не копируются
+    explicit IndexedSingleLinkedList(List&& list)
+        : list_(std::move(list)) {
+        Rebuild();
+    }
+
+    IndexedSingleLinkedList(const IndexedSingleLinkedList& other)
+        : list_(other.list_) {
+        Rebuild();
+    }
+
+    // Перемещение сохраняет узлы, поэтому индекс переносится вместе с ними
+    IndexedSingleLinkedList(IndexedSingleLinkedList&& other) noexcept {
+        swap(other);
+    }
+
+    IndexedSingleLinkedList& operator=(const IndexedSingleLinkedList& rhs) {
+        if (this != &rhs) {
+            IndexedSingleLinkedList copy(rhs);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    IndexedSingleLinkedList& operator=(IndexedSingleLinkedList&& rhs) noexcept {
+        if (this != &rhs) {
+            IndexedSingleLinkedList moved(std::move(rhs));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    void swap(IndexedSingleLinkedList& other) noexcept {
+        list_.swap(other.list_);
+        segments_.swap(other.segments_);
+        segment_by_first_.swap(other.segment_by_first_);
+        std::swap(segment_size_, other.segment_size_);
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return list_.GetSize();
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return list_.IsEmpty();
+    }
+
+    // Список без индекса, например для сравнения или сериализации
+    [[nodiscard]] const List& GetList() const noexcept {
+        return list_;
+    }
+
+    // Забирает узлы в обычный список, индекс становится пустым
+    [[nodiscard]] List Release() noexcept {
+        List list(std::move(list_));
+        segments_.clear();
+        segment_by_first_.clear();
+        segment_size_ = MIN_SEGMENT_SIZE;
+        return list;
+    }
+
+    [[nodiscard]] Iterator begin() noexcept {
+        return list_.begin();
+    }
+
+    [[nodiscard]] Iterator end() noexcept {
+        return list_.end();
+    }
+
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        return list_.begin();
+    }
+
+    [[nodiscard]] ConstIterator end() const noexcept {
+        return list_.end();
+    }
+
+    [[nodiscard]] ConstIterator cbegin() const noexcept {
+        return list_.cbegin();
+    }
+
+    [[nodiscard]] ConstIterator cend() const noexcept {
+        return list_.cend();
+    }
+
+    [[nodiscard]] Iterator before_begin() noexcept {
+        return list_.before_begin();
+    }
+
+    [[nodiscard]] ConstIterator cbefore_begin() const noexcept {
+        return list_.cbefore_begin();
+    }
+
+    // Возвращает ссылку на элемент с номером index за время O(√N).
+    // Если index >= GetSize(), выбрасывает std::out_of_range
+    [[nodiscard]] Type& At(size_t index) {
+        CheckIndex(index);
+        return *IteratorAt(index);
+    }
+
+    [[nodiscard]] const Type& At(size_t index) const {
+        CheckIndex(index);
+        return *IteratorAt(index);
+    }
+
+    // Возвращает итератор на элемент с номером index за время O(√N), при index == GetSize() - end()
+    [[nodiscard]] Iterator IteratorAt(size_t index) noexcept {
+        assert(index <= GetSize());
+        for (const Segment& segment : segments_) {
+            if (index < segment.count) {
+                return std::next(segment.first, static_cast<std::ptrdiff_t>(index));
+            }
+            index -= segment.count;
+        }
+        return end();
+    }
+
+    [[nodiscard]] ConstIterator IteratorAt(size_t index) const noexcept {
+        return const_cast<IndexedSingleLinkedList&>(*this).IteratorAt(index);
+    }
+
+    // Возвращает итератор на первый элемент, не меньший value, либо end().
+    // Элементы должны быть упорядочены по возрастанию. Время работы O(log N + √N)
+    [[nodiscard]] ConstIterator LowerBound(const Type& value) const {
+        return std::next(LowerBoundBefore(value));
+    }
+
+    // Возвращает итератор на элемент, предшествующий LowerBound(value), либо before_begin().
+    // Вставка после него через InsertAfter сохраняет порядок элементов
+    [[nodiscard]] ConstIterator LowerBoundBefore(const Type& value) const {
+        return FindLowerBoundBefore(value).first;
+    }
+
+    // Вставляет value в упорядоченный по возрастанию список перед первым элементом, не меньшим value
+    Iterator InsertSorted(const Type& value) {
+        const auto [pos, segment] = FindLowerBoundBefore(value);
+        return Insert(segment, pos, value);
+    }
+
+    Iterator InsertSorted(Type&& value) {
+        const auto [pos, segment] = FindLowerBoundBefore(value);
+        return Insert(segment, pos, std::move(value));
+    }
+
+    void PushFront(const Type& value) {
+        Insert(0, cbefore_begin(), value);
+    }
+
+    void PushFront(Type&& value) {
+        Insert(0, cbefore_begin(), std::move(value));
+    }
+
+    // Вставляет value после pos. Участок pos находится за время O(√N)
+    Iterator InsertAfter(ConstIterator pos, const Type& value) {
+        return Insert(SegmentOf(pos), pos, value);
+    }
+
+    Iterator InsertAfter(ConstIterator pos, Type&& value) {
+        return Insert(SegmentOf(pos), pos, std::move(value));
+    }
+
+    void PopFront() {
+        assert(!IsEmpty());
+        EraseAfter(cbefore_begin());
+    }
+
+    // Удаляет элемент, следующий за pos. Возвращает итератор на элемент, следующий за удалённым
+    Iterator EraseAfter(ConstIterator pos) {
+        const ConstIterator erased = std::next(pos);
+        const size_t segment = SegmentOf(erased);
+        const Type* erased_key = std::addressof(*erased);
+        const bool was_first = segments_[segment].first == erased;
+        Iterator next = list_.EraseAfter(pos);
+        Segment& current = segments_[segment];
+        --current.count;
+        if (was_first) {
+            if (current.count == 0) {
+                segment_by_first_.erase(erased_key);
+                segments_.erase(segments_.begin() + static_cast<std::ptrdiff_t>(segment));
+                Renumber(segment);
+                MaybeRebuild();
+                return next;
+            }
+            // Узел хеш-таблицы переиспользуется, поэтому смена ключа не выделяет память
+            auto node = segment_by_first_.extract(erased_key);
+            node.key() = std::addressof(*next);
+            segment_by_first_.insert(std::move(node));
+            current.first = next;
+        }
+        if (current.count < segment_size_ / 2) {
+            Merge(segment);
+        }
+        MaybeRebuild();
+        return next;
+    }
+
+    void Clear() noexcept {
+        list_.Clear();
+        segments_.clear();
+        segment_by_first_.clear();
+        segment_size_ = MIN_SEGMENT_SIZE;
+    }
+
+private:
+    // Участок цепочки: первый элемент и количество элементов
+    struct Segment {
+        Iterator first;
+        size_t count = 0;
+    };
+
+    // Наименьшая длина участка: на коротких списках индекс не должен быть плотнее самих данных
+    static constexpr size_t MIN_SEGMENT_SIZE = 32;
+    static constexpr size_t SEGMENT_SIZE_DIVISOR = 4;
+
+    void CheckIndex(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("IndexedSingleLinkedList: index out of range");
+        }
+    }
+
+    // Возвращает номер участка, которому принадлежит элемент pos.
+    // before_begin относится к первому участку: вставка после него меняет начало этого участка
+    [[nodiscard]] size_t SegmentOf(ConstIterator pos) const {
+        if (pos == cbefore_begin()) {
+            return 0;
+        }
+        // Ближайшее начало участка не дальше двух длин участка
+        for (ConstIterator it = pos; it != cend(); ++it) {
+            const auto found = segment_by_first_.find(std::addressof(*it));
+            if (found != segment_by_first_.end()) {
+                return it == pos ? found->second : found->second - 1;
+            }
+        }
+        return segments_.size() - 1;
+    }
+
+    // Находит элемент перед LowerBound(value) и номер его участка
+    [[nodiscard]] std::pair<ConstIterator, size_t> FindLowerBoundBefore(const Type& value) const {
+        // Первые элементы участков упорядочены, поэтому участок находится двоичным поиском
+        const auto after = std::partition_point(segments_.begin(), segments_.end(), [&value](const Segment& segment) {
+            return *segment.first < value;
+        });
+        if (after == segments_.begin()) {
+            return { cbefore_begin(), 0 };
+        }
+        const Segment& segment = *std::prev(after);
+        ConstIterator prev = segment.first;
+        ConstIterator it = std::next(prev);
+        for (size_t i = 1; i < segment.count && *it < value; ++i) {
+            prev = it;
+            ++it;
+        }
+        return { prev, static_cast<size_t>(std::prev(after) - segments_.begin()) };
+    }
+
+    // Вставляет элемент после pos, который принадлежит участку segment
+    template <typename... Args>
+    Iterator Insert(size_t segment, ConstIterator pos, Args&&... args) {
+        const bool at_front = pos == cbefore_begin();
+        Iterator inserted = list_.EmplaceAfter(pos, std::forward<Args>(args)...);
+        try {
+            if (segments_.empty()) {
+                segments_.push_back({ inserted, 1 });
+                segment_by_first_.emplace(std::addressof(*inserted), 0);
+                return inserted;
+            }
+            if (at_front) {
+                segment_by_first_.emplace(std::addressof(*inserted), 0);
+                segment_by_first_.erase(std::addressof(*segments_[0].first));
+                segments_[0].first = inserted;
+            }
+            if (++segments_[segment].count > 2 * segment_size_) {
+                Split(segment);
+            }
+            MaybeRebuild();
+        } catch (...) {
+            // Индекс не удалось дополнить: элемент удаляется, а индекс строится заново по прежним узлам
+            list_.EraseAfter(pos);
+            Rebuild();
+            throw;
+        }
+        return inserted;
+    }
+
+    // Отделяет от участка всё, что идёт после первых segment_size_ элементов, в новый участок
+    void Split(size_t segment) {
+        Segment& current = segments_[segment];
+        const Segment tail{ std::next(current.first, static_cast<std::ptrdiff_t>(segment_size_)), current.count - segment_size_ };
+        segment_by_first_.emplace(std::addressof(*tail.first), segment + 1);
+        current.count = segment_size_;
+        segments_.insert(segments_.begin() + static_cast<std::ptrdiff_t>(segment + 1), tail);
+        Renumber(segment + 2);
+    }
+
+    // Присоединяет короткий участок к соседнему. Слишком длинный результат делится пополам
+    void Merge(size_t segment) {
+        if (segments_.size() < 2) {
+            return;
+        }
+        if (segment + 1 == segments_.size()) {
+            --segment;
+        }
+        Segment& current = segments_[segment];
+        const Segment next = segments_[segment + 1];
+        current.count += next.count;
+        segment_by_first_.erase(std::addressof(*next.first));
+        segments_.erase(segments_.begin() + static_cast<std::ptrdiff_t>(segment + 1));
+        Renumber(segment + 1);
+        if (segments_[segment].count > 2 * segment_size_) {
+            Split(segment);
+        }
+    }
+
+    // Обновляет номера участков, начиная с from, после вставки или удаления участка
+    void Renumber(size_t from) {
+        for (size_t i = from; i < segments_.size(); ++i) {
+            segment_by_first_.find(std::addressof(*segments_[i].first))->second = i;
+        }
+    }
+
+    // Длина участка для списка из size элементов. Переход по узлу обычно стоит промаха кэша,
+    // а участки перебираются по непрерывному вектору, поэтому участки делаются в несколько раз короче √N
+    static size_t TargetSegmentSize(size_t size) noexcept {
+        return std::max(MIN_SEGMENT_SIZE, static_cast<size_t>(std::sqrt(static_cast<double>(size))) / SEGMENT_SIZE_DIVISOR);
+    }
+
+    // Перестраивает индекс, когда подходящая длина участка отличается от текущей больше чем вдвое.
+    // Между перестройками проходит Θ(N) вставок или удалений, поэтому их стоимость амортизируется
+    void MaybeRebuild() {
+        const size_t target = TargetSegmentSize(GetSize());
+        if (target > 2 * segment_size_ || 2 * target < segment_size_) {
+            Rebuild();
+        }
+    }
+
+    // Делит цепочку на участки за один проход
+    void Rebuild() {
+        const size_t size = GetSize();
+        segment_size_ = TargetSegmentSize(size);
+        segments_.clear();
+        segment_by_first_.clear();
+        segments_.reserve(size / segment_size_ + 1);
+        segment_by_first_.reserve(size / segment_size_ + 1);
+        size_t in_segment = 0;
+        for (Iterator it = list_.begin(); it != list_.end(); ++it) {
+            if (in_segment == 0) {
+                segment_by_first_.emplace(std::addressof(*it), segments_.size());
+                segments_.push_back({ it, 0 });
+            }
+            ++segments_.back().count;
+            if (++in_segment == segment_size_) {
+                in_segment = 0;
+            }
+        }
+        // Короткий последний участок присоединяется к предыдущему
+        if (segments_.size() > 1 && segments_.back().count < segment_size_ / 2) {
+            Merge(segments_.size() - 1);
+        }
+    }
+
+    List list_;
+    std::vector<Segment> segments_;
+    // Номер участка по адресу его первого элемента
+    std::unordered_map<const Type*, size_t> segment_by_first_;
+    size_t segment_size_ = MIN_SEGMENT_SIZE;
+};
+
+template <typename Type, typename Allocator>
+void swap(IndexedSingleLinkedList<Type, Allocator>& lhs, IndexedSingleLinkedList<Type, Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+// Звено односвязного списка, встраиваемое в элемент базовым классом.
+// Tag различает звенья, если один объект должен одновременно состоять в нескольких списках:
+// struct Order : IntrusiveListHook<ByPrice>, IntrusiveListHook<ByTime> { ... };
+// Связь принадлежит месту объекта в списке, а не его значению, поэтому она не копируется:
+// копия создаётся не связанной, а присваивание не меняет связь элемента, стоящего в списке
+template <typename Tag = void>
+struct IntrusiveListHook {
+    IntrusiveListHook() = default;
+
+    IntrusiveListHook(const IntrusiveListHook&) noexcept {
+    }
+
+    IntrusiveListHook& operator=(const IntrusiveListHook&) noexcept {
+        return *this;
+    }
+
+    IntrusiveListHook* next_node = nullptr;
+};
+
+// Интрузивный односвязный список. Связь хранится в самих элементах (в базе IntrusiveListHook<Tag>),
+// поэтому список ничего не выделяет и не владеет элементами: вставка и удаление только перецепляют указатели.
+// Итераторы, before_begin, InsertAfter и EraseAfter ведут себя так же, как у SingleLinkedList.
+// Элемент может состоять не больше чем в одном списке с тем же Tag и должен жить, пока состоит в нём
+template <typename Type, typename Tag = void>
+class IntrusiveSingleLinkedList {
+    using Hook = IntrusiveListHook<Tag>;
+
+    static_assert(std::is_base_of_v<Hook, Type>, "Type must derive from IntrusiveListHook<Tag>");
+
+    // Элемент, содержащий звено node. node не должен быть фиктивным звеном
+    static Type& ValueOf(Hook* node) noexcept {
+        return static_cast<Type&>(*node);
+    }
+
+    template <typename ValueType>
+    class BasicIterator {
+        friend class IntrusiveSingleLinkedList;
+
+        explicit BasicIterator(Hook* node) noexcept
+            : node_(node) {
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueType*;
+        using reference = ValueType&;
+
+        BasicIterator() = default;
+
+        // При ValueType, совпадающем с Type, играет роль копирующего конструктора,
+        // при const Type - конвертирующего
+        BasicIterator(const BasicIterator<Type>& other) noexcept
+            : node_(other.node_) {
+        }
+
+        BasicIterator& operator=(const BasicIterator& rhs) = default;
+
+        [[nodiscard]] bool operator==(const BasicIterator<const Type>& rhs) const noexcept {
+            return node_ == rhs.node_;
+        }
+
+        [[nodiscard]] bool operator!=(const BasicIterator<const Type>& rhs) const noexcept {
+            return node_ != rhs.node_;
+        }
+
+        [[nodiscard]] bool operator==(const BasicIterator<Type>& rhs) const noexcept {
+            return node_ == rhs.node_;
+        }
+
+        [[nodiscard]] bool operator!=(const BasicIterator<Type>& rhs) const noexcept {
+            return node_ != rhs.node_;
+        }
+
+        BasicIterator& operator++() noexcept {
+            node_ = node_->next_node;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            auto old_value(*this);
+            node_ = node_->next_node;
+            return old_value;
+        }
+
+        [[nodiscard]] reference operator*() const noexcept {
+            return ValueOf(node_);
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept {
+            assert(node_ != nullptr);
+            return &ValueOf(node_);
+        }
+
+    private:
+        Hook* node_ = nullptr;
+    };
+
+public:
+    using value_type = Type;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+
+    IntrusiveSingleLinkedList() = default;
+
+    // Список не владеет элементами, поэтому копировать его нельзя: элемент не может состоять в двух списках
+    IntrusiveSingleLinkedList(const IntrusiveSingleLinkedList&) = delete;
+    IntrusiveSingleLinkedList& operator=(const IntrusiveSingleLinkedList&) = delete;
+
+    IntrusiveSingleLinkedList(IntrusiveSingleLinkedList&& other) noexcept {
+        swap(other);
+    }
+
+    IntrusiveSingleLinkedList& operator=(IntrusiveSingleLinkedList&& rhs) noexcept {
+        if (this != &rhs) {
+            Clear();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Вставляет value в начало списка за время O(1)
+    void PushFront(Type& value) noexcept {
+        InsertAfter(cbefore_begin(), value);
+    }
+
+    // Вставляет value в конец списка за время O(1)
+    void PushBack(Type& value) noexcept {
+        InsertAfter(ConstIterator{ tail_ }, value);
+    }
+
+    // Исключает первый элемент из списка. Сам элемент не разрушается
+    void PopFront() noexcept {
+        assert(!IsEmpty());
+        EraseAfter(cbefore_begin());
+    }
+
+    [[nodiscard]] Type& front() noexcept {
+        assert(!IsEmpty());
+        return ValueOf(head_.next_node);
+    }
+
+    [[nodiscard]] const Type& front() const noexcept {
+        assert(!IsEmpty());
+        return ValueOf(head_.next_node);
+    }
+
+    [[nodiscard]] Type& back() noexcept {
+        assert(!IsEmpty());
+        return ValueOf(tail_);
+    }
+
+    [[nodiscard]] const Type& back() const noexcept {
+        assert(!IsEmpty());
+        return ValueOf(tail_);
+    }
+
+    /*
+     * Вставляет value после элемента, на который указывает pos, за время O(1).
+     * Возвращает итератор на вставленный элемент.
+     * value не должен состоять в другом списке с тем же Tag
+     */
+    Iterator InsertAfter(ConstIterator pos, Type& value) noexcept {
+        Hook* node = &static_cast<Hook&>(value);
+        node->next_node = pos.node_->next_node;
+        pos.node_->next_node = node;
+        if (pos.node_ == tail_) {
+            tail_ = node;
+        }
+        ++size_;
+        return Iterator{ node };
+    }
+
+    /*
+     * Исключает из списка элемент, следующий за pos, за время O(1). Сам элемент не разрушается.
+     * Возвращает итератор на элемент, следующий за исключённым
+     */
+    Iterator EraseAfter(ConstIterator pos) noexcept {
+        assert(pos.node_->next_node != nullptr);
+        Hook* erased = pos.node_->next_node;
+        pos.node_->next_node = erased->next_node;
+        if (erased == tail_) {
+            tail_ = pos.node_;
+        }
+        erased->next_node = nullptr;
+        --size_;
+        return Iterator{ pos.node_->next_node };
+    }
+
+    // Исключает все элементы за время O(1). Звенья элементов не обнуляются
+    void Clear() noexcept {
+        head_.next_node = nullptr;
+        tail_ = &head_;
+        size_ = 0;
+    }
+
+    // Возвращает итератор на value за время O(1). value должен состоять в этом списке
+    [[nodiscard]] Iterator IteratorTo(Type& value) noexcept {
+        return Iterator{ &static_cast<Hook&>(value) };
+    }
+
+    [[nodiscard]] ConstIterator IteratorTo(const Type& value) const noexcept {
+        return ConstIterator{ const_cast<Hook*>(&static_cast<const Hook&>(value)) };
+    }
+
+    void swap(IntrusiveSingleLinkedList& other) noexcept {
+        std::swap(head_.next_node, other.head_.next_node);
+        std::swap(tail_, other.tail_);
+        std::swap(size_, other.size_);
+        // Пустой список хранит в tail_ адрес собственного фиктивного звена
+        if (tail_ == &other.head_) {
+            tail_ = &head_;
+        }
+        if (other.tail_ == &head_) {
+            other.tail_ = &other.head_;
+        }
+    }
+
+    [[nodiscard]] Iterator begin() noexcept {
+        return Iterator{ head_.next_node };
+    }
+
+    [[nodiscard]] Iterator end() noexcept {
+        return {};
+    }
+
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        return cbegin();
+    }
+
+    [[nodiscard]] ConstIterator end() const noexcept {
+        return cend();
+    }
+
+    [[nodiscard]] ConstIterator cbegin() const noexcept {
+        return ConstIterator{ head_.next_node };
+    }
+
+    [[nodiscard]] ConstIterator cend() const noexcept {
+        return {};
+    }
+
+    // Итератор на позицию перед первым элементом. Разыменовывать его нельзя
+    [[nodiscard]] Iterator before_begin() noexcept {
+        return Iterator{ &head_ };
+    }
+
+    [[nodiscard]] ConstIterator cbefore_begin() const noexcept {
+        return ConstIterator{ const_cast<Hook*>(&head_) };
+    }
+
+    [[nodiscard]] ConstIterator before_begin() const noexcept {
+        return cbefore_begin();
+    }
+
+private:
+    // Фиктивное звено, используется для вставки "перед первым элементом"
+    Hook head_;
+    // Последнее звено списка, у пустого списка указывает на head_
+    Hook* tail_ = &head_;
+    size_t size_ = 0;
+};
+
+template <typename Type, typename Tag>
+void swap(IntrusiveSingleLinkedList<Type, Tag>& lhs, IntrusiveSingleLinkedList<Type, Tag>& rhs) noexcept {
+    lhs.swap(rhs);
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include <istream>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SINGLE_LINKED_LIST_HAS_MMAP 1
+#else
+#define SINGLE_LINKED_LIST_HAS_MMAP 0
+#endif
+
+#include "single-linked-list.h"
+
+/*
+ * Двоичный формат списка тривиально копируемых элементов:
+ *   заголовок (16 байт): сигнатура, версия формата, размер элемента, количество элементов
+ *   данные: элементы подряд в порядке списка, без промежутков
+ * Числа записываются в порядке байтов машины, поэтому файл читается на машине той же архитектуры
+ */
+
+// Ошибка чтения: повреждённый или обрезанный поток, неизвестная версия, другой тип элементов
+class ListFormatError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+namespace detail {
+
+inline constexpr uint32_t LIST_FORMAT_MAGIC = 0x314C4C53;  // "SLL1"
+inline constexpr uint16_t LIST_FORMAT_VERSION = 1;
+
+struct ListFormatHeader {
+    uint32_t magic = LIST_FORMAT_MAGIC;
+    uint16_t version = LIST_FORMAT_VERSION;
+    uint16_t value_size = 0;
+    uint64_t count = 0;
+};
+
+static_assert(sizeof(ListFormatHeader) == 16 && std::is_trivially_copyable_v<ListFormatHeader>);
+
+// Размер буфера, которым элементы пишутся в поток
+inline constexpr size_t SERIALIZE_BUFFER_SIZE = 64 * 1024;
+
+template <typename Type>
+void CheckSerializable() {
+    static_assert(std::is_trivially_copyable_v<Type>, "Serialized elements must be trivially copyable");
+    static_assert(sizeof(Type) <= UINT16_MAX, "Serialized elements are too large");
+}
+
+// Проверяет заголовок и возвращает количество элементов.
+// available - сколько байт данных доступно после заголовка, если это известно заранее
+template <typename Type>
+size_t CheckHeader(const ListFormatHeader& header, uint64_t available = UINT64_MAX) {
+    if (header.magic != LIST_FORMAT_MAGIC) {
+        throw ListFormatError("SingleLinkedList: not a serialized list");
+    }
+    if (header.version != LIST_FORMAT_VERSION) {
+        throw ListFormatError("SingleLinkedList: unsupported format version " + std::to_string(header.version));
+    }
+    if (header.value_size != sizeof(Type)) {
+        throw ListFormatError("SingleLinkedList: element size mismatch");
+    }
+    if (header.count > available / sizeof(Type) || header.count > SIZE_MAX / sizeof(Type)) {
+        throw ListFormatError("SingleLinkedList: truncated data");
+    }
+    return static_cast<size_t>(header.count);
+}
+
+// Буфер, выровненный для Type, в который читается очередная порция данных
+template <typename Type>
+struct RecordBuffer {
+    struct Free {
+        void operator()(Type* data) const noexcept {
+            ::operator delete(data, std::align_val_t{ alignof(Type) });
+        }
+    };
+
+    explicit RecordBuffer(size_t count)
+        : data(static_cast<Type*>(::operator new(count * sizeof(Type), std::align_val_t{ alignof(Type) }))) {
+    }
+
+    std::unique_ptr<Type, Free> data;
+};
+
+}  // namespace detail
+
+// Записывает размер и элементы списка в поток. Элементы копируются в буфер и пишутся крупными порциями
+template <typename Type, typename Allocator, typename Stats, size_t InlineNodes>
+void Serialize(std::ostream& output, const SingleLinkedList<Type, Allocator, Stats, InlineNodes>& list) {
+    detail::CheckSerializable<Type>();
+    detail::ListFormatHeader header;
+    header.value_size = static_cast<uint16_t>(sizeof(Type));
+    header.count = list.GetSize();
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    const size_t buffer_records = std::max<size_t>(1, std::min(detail::SERIALIZE_BUFFER_SIZE / sizeof(Type), list.GetSize()));
+    std::unique_ptr<char[]> buffer(new char[buffer_records * sizeof(Type)]);
+    size_t buffered = 0;
+    for (const Type& value : list) {
+        std::memcpy(buffer.get() + buffered * sizeof(Type), &value, sizeof(Type));
+        if (++buffered == buffer_records) {
+            output.write(buffer.get(), static_cast<std::streamsize>(buffered * sizeof(Type)));
+            buffered = 0;
+        }
+    }
+    output.write(buffer.get(), static_cast<std::streamsize>(buffered * sizeof(Type)));
+    if (!output) {
+        throw std::ios_base::failure("SingleLinkedList: write failed");
+    }
+}
+
+namespace detail {
+
+// Сколько байт осталось в потоке от текущей позиции, либо UINT64_MAX, если поток не поддерживает позиционирование
+inline uint64_t RemainingBytes(std::istream& input) {
+    const std::istream::pos_type start = input.tellg();
+    if (start == std::istream::pos_type(-1)) {
+        return UINT64_MAX;
+    }
+    input.seekg(0, std::ios::end);
+    const std::istream::pos_type end = input.tellg();
+    input.clear();
+    input.seekg(start);
+    if (!input || end == std::istream::pos_type(-1) || end < start) {
+        throw ListFormatError("SingleLinkedList: cannot seek stream");
+    }
+    return static_cast<uint64_t>(end - start);
+}
+
+}  // namespace detail
+
+/*
+ * Заменяет содержимое списка элементами из потока, записанного Serialize.
+ * Количество элементов в заголовке не проверено, поэтому память под них заранее не выделяется:
+ * если поток поддерживает позиционирование, количество сразу сверяется с оставшимся размером потока.
+ * Данные читаются порциями по SERIALIZE_BUFFER_SIZE байт, и узлы каждой порции присоединяются
+ * к хвосту нового списка, так что кроме узлов нужен только буфер одной порции.
+ * С аллокатором, выделяющим участки, память под узлы порции выделяется одним блоком.
+ * При ошибке выбрасывается ListFormatError, и список остаётся в прежнем состоянии
+ */
+template <typename Type, typename Allocator, typename Stats, size_t InlineNodes>
+void Deserialize(std::istream& input, SingleLinkedList<Type, Allocator, Stats, InlineNodes>& list) {
+    detail::CheckSerializable<Type>();
+    detail::ListFormatHeader header;
+    if (!input.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw ListFormatError("SingleLinkedList: truncated header");
+    }
+    const size_t count = detail::CheckHeader<Type>(header, detail::RemainingBytes(input));
+    if (count == 0) {
+        list.Clear();
+        return;
+    }
+    const size_t chunk_records = std::max<size_t>(1, std::min(detail::SERIALIZE_BUFFER_SIZE / sizeof(Type), count));
+    detail::RecordBuffer<Type> buffer(chunk_records);
+    SingleLinkedList<Type, Allocator, Stats, InlineNodes> loaded(list.get_allocator());
+    auto tail = loaded.cbefore_begin();
+    for (size_t left = count; left > 0;) {
+        const size_t records = std::min(chunk_records, left);
+        const auto bytes = static_cast<std::streamsize>(records * sizeof(Type));
+        if (!input.read(reinterpret_cast<char*>(buffer.data.get()), bytes)) {
+            throw ListFormatError("SingleLinkedList: truncated data");
+        }
+        tail = loaded.InsertAfter(tail, buffer.data.get(), buffer.data.get() + records);
+        left -= records;
+    }
+    list.swap(loaded);
+}
+
+// Записывает список в файл path
+template <typename Type, typename Allocator, typename Stats, size_t InlineNodes>
+void SaveToFile(const std::string& path, const SingleLinkedList<Type, Allocator, Stats, InlineNodes>& list) {
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        throw std::ios_base::failure("SingleLinkedList: cannot open " + path);
+    }
+    Serialize(output, list);
+}
+
+/*
+ * Заменяет содержимое списка элементами из файла path, записанного SaveToFile или Serialize.
+ * Где доступен mmap, файл отображается в память и узлы копируют элементы прямо из отображения,
+ * без промежуточного буфера. Иначе файл читается через Deserialize.
+ * При ошибке список остаётся в прежнем состоянии
+ */
+template <typename Type, typename Allocator, typename Stats, size_t InlineNodes>
+void LoadFromFile(const std::string& path, SingleLinkedList<Type, Allocator, Stats, InlineNodes>& list) {
+    detail::CheckSerializable<Type>();
+#if SINGLE_LINKED_LIST_HAS_MMAP
+    // Отображение начинается с границы страницы, а данные идут сразу за 16-байтовым заголовком
+    if constexpr (alignof(Type) <= sizeof(detail::ListFormatHeader)) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::ios_base::failure("SingleLinkedList: cannot open " + path);
+        }
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::ios_base::failure("SingleLinkedList: cannot stat " + path);
+        }
+        const auto file_size = static_cast<uint64_t>(info.st_size);
+        if (file_size < sizeof(detail::ListFormatHeader)) {
+            ::close(fd);
+            throw ListFormatError("SingleLinkedList: truncated header");
+        }
+        void* mapping = ::mmap(nullptr, static_cast<size_t>(file_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            throw std::ios_base::failure("SingleLinkedList: cannot map " + path);
+        }
+        struct Unmap {
+            void* data;
+            size_t size;
+
+            ~Unmap() {
+                ::munmap(data, size);
+            }
+        } unmap{ mapping, static_cast<size_t>(file_size) };
+#ifdef MADV_SEQUENTIAL
+        ::madvise(mapping, unmap.size, MADV_SEQUENTIAL);
+#endif
+
+        detail::ListFormatHeader header;
+        std::memcpy(&header, mapping, sizeof(header));
+        const size_t count = detail::CheckHeader<Type>(header, file_size - sizeof(header));
+        const auto* first = reinterpret_cast<const Type*>(static_cast<const char*>(mapping) + sizeof(header));
+        list.Assign(first, first + count);
+        return;
+    }
+#endif
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        throw std::ios_base::failure("SingleLinkedList: cannot open " + path);
+    }
+    Deserialize(input, list);
+}
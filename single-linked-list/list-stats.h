@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Операции со временем работы O(N), время которых учитывает ListStats
+enum class ListOperation {
+    CLEAR,
+    COPY,
+    SORT,
+    MERGE,
+    REMOVE,
+    COMPACT,
+    COUNT
+};
+
+// Политика статистики по умолчанию. Все методы пустые, а SingleLinkedList наследуется
+// от политики, поэтому при выключенной статистике не расходуется ни память, ни время
+struct NoListStats {
+    struct Timer {};
+
+    void OnAllocate(size_t) noexcept {
+    }
+
+    void OnFree(size_t) noexcept {
+    }
+
+    void OnCopy(size_t) noexcept {
+    }
+
+    void OnSplice() noexcept {
+    }
+
+    void OnSize(size_t) noexcept {
+    }
+
+    [[nodiscard]] Timer Time(ListOperation) noexcept {
+        return {};
+    }
+};
+
+// Снимок счётчиков ListStats
+struct ListStatsSnapshot {
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t copies = 0;
+    uint64_t splices = 0;
+    uint64_t peak_size = 0;
+    uint64_t operation_counts[static_cast<size_t>(ListOperation::COUNT)] = {};
+    uint64_t operation_nanoseconds[static_cast<size_t>(ListOperation::COUNT)] = {};
+};
+
+// Политика, считающая выделения и освобождения узлов, скопированные элементы,
+// переносы цепочек узлов, пиковый размер и время операций O(N).
+// Счётчики меняет только поток, владеющий списком, а Snapshot можно вызывать из любого потока
+class ListStats {
+public:
+    // Замеряет время операции от создания до разрушения
+    class Timer {
+    public:
+        Timer(ListStats& stats, ListOperation operation) noexcept
+            : stats_(stats)
+            , operation_(operation)
+            , start_(std::chrono::steady_clock::now()) {
+        }
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        ~Timer() {
+            const auto elapsed = std::chrono::steady_clock::now() - start_;
+            const size_t index = static_cast<size_t>(operation_);
+            Add(stats_.operation_counts_[index], 1);
+            Add(stats_.operation_nanoseconds_[index],
+                static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+
+    private:
+        ListStats& stats_;
+        ListOperation operation_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    ListStats() = default;
+    ListStats(const ListStats&) = delete;
+    ListStats& operator=(const ListStats&) = delete;
+
+    void OnAllocate(size_t count) noexcept {
+        Add(allocations_, count);
+    }
+
+    void OnFree(size_t count) noexcept {
+        Add(frees_, count);
+    }
+
+    void OnCopy(size_t count) noexcept {
+        Add(copies_, count);
+    }
+
+    void OnSplice() noexcept {
+        Add(splices_, 1);
+    }
+
+    void OnSize(size_t size) noexcept {
+        if (size > peak_size_.load(std::memory_order_relaxed)) {
+            peak_size_.store(size, std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] Timer Time(ListOperation operation) noexcept {
+        return Timer(*this, operation);
+    }
+
+    [[nodiscard]] ListStatsSnapshot Snapshot() const noexcept {
+        ListStatsSnapshot snapshot;
+        snapshot.allocations = allocations_.load(std::memory_order_relaxed);
+        snapshot.frees = frees_.load(std::memory_order_relaxed);
+        snapshot.copies = copies_.load(std::memory_order_relaxed);
+        snapshot.splices = splices_.load(std::memory_order_relaxed);
+        snapshot.peak_size = peak_size_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < static_cast<size_t>(ListOperation::COUNT); ++i) {
+            snapshot.operation_counts[i] = operation_counts_[i].load(std::memory_order_relaxed);
+            snapshot.operation_nanoseconds[i] = operation_nanoseconds_[i].load(std::memory_order_relaxed);
+        }
+        return snapshot;
+    }
+
+private:
+    // Писатель у счётчика один, поэтому вместо атомарного инкремента
+    // достаточно пары relaxed-операций, которые не блокируют шину
+    static void Add(std::atomic<uint64_t>& counter, uint64_t delta) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> allocations_{ 0 };
+    std::atomic<uint64_t> frees_{ 0 };
+    std::atomic<uint64_t> copies_{ 0 };
+    std::atomic<uint64_t> splices_{ 0 };
+    std::atomic<uint64_t> peak_size_{ 0 };
+    std::atomic<uint64_t> operation_counts_[static_cast<size_t>(ListOperation::COUNT)] = {};
+    std::atomic<uint64_t> operation_nanoseconds_[static_cast<size_t>(ListOperation::COUNT)] = {};
+};
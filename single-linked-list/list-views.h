@@ -0,0 +1,671 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define SINGLE_LINKED_LIST_HAS_GENERATOR 1
+#else
+#define SINGLE_LINKED_LIST_HAS_GENERATOR 0
+#endif
+
+#include "single-linked-list.h"
+
+/*
+ * Ленивые представления над списками и другими диапазонами.
+ * Lazy(list).Filter(pred).Transform(fn).Take(n).Collect() не создаёт промежуточных списков:
+ * каждая стадия - лёгкий объект с итераторами поверх итераторов предыдущей стадии,
+ * и элементы вычисляются по одному при обходе. Память выделяет только Collect.
+ * Представление не владеет исходным диапазоном, и тот должен жить, пока представление обходят.
+ * Итераторы стадий ссылаются на предикаты и функции, хранящиеся в представлении,
+ * поэтому действительны, пока живо представление, у которого они получены
+ */
+
+namespace detail {
+
+template <typename Range>
+using RangeIterator = decltype(std::declval<const Range&>().begin());
+
+// Стадия сохраняет многопроходность исходного итератора, иначе её итератор - итератор ввода
+template <typename Iter>
+using ViewIteratorCategory = std::conditional_t<IS_FORWARD_ITERATOR<Iter>, std::forward_iterator_tag, std::input_iterator_tag>;
+
+}  // namespace detail
+
+// Пара итераторов, с которой начинается цепочка стадий
+template <typename Iter>
+class IteratorRange {
+public:
+    IteratorRange(Iter first, Iter last)
+        : first_(std::move(first))
+        , last_(std::move(last)) {
+    }
+
+    [[nodiscard]] Iter begin() const {
+        return first_;
+    }
+
+    [[nodiscard]] Iter end() const {
+        return last_;
+    }
+
+private:
+    Iter first_;
+    Iter last_;
+};
+
+// Элементы базового диапазона, для которых pred возвращает true
+template <typename Base, typename Pred>
+class FilterView {
+    using BaseIterator = detail::RangeIterator<Base>;
+
+public:
+    class Iterator {
+        friend class FilterView;
+
+        Iterator(BaseIterator it, BaseIterator last, const Pred* pred)
+            : it_(std::move(it))
+            , last_(std::move(last))
+            , pred_(pred) {
+            SkipRejected();
+        }
+
+    public:
+        using iterator_category = detail::ViewIteratorCategory<BaseIterator>;
+        using value_type = typename std::iterator_traits<BaseIterator>::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = typename std::iterator_traits<BaseIterator>::reference;
+
+        Iterator() = default;
+
+        [[nodiscard]] bool operator==(const Iterator& rhs) const {
+            return it_ == rhs.it_;
+        }
+
+        [[nodiscard]] bool operator!=(const Iterator& rhs) const {
+            return !(*this == rhs);
+        }
+
+        Iterator& operator++() {
+            ++it_;
+            SkipRejected();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto old_value(*this);
+            ++*this;
+            return old_value;
+        }
+
+        [[nodiscard]] reference operator*() const {
+            return *it_;
+        }
+
+    private:
+        void SkipRejected() {
+            while (it_ != last_ && !(*pred_)(*it_)) {
+                ++it_;
+            }
+        }
+
+        BaseIterator it_{};
+        BaseIterator last_{};
+        const Pred* pred_ = nullptr;
+    };
+
+    FilterView(Base base, Pred pred)
+        : base_(std::move(base))
+        , pred_(std::move(pred)) {
+    }
+
+    [[nodiscard]] Iterator begin() const {
+        return Iterator{ base_.begin(), base_.end(), &pred_ };
+    }
+
+    [[nodiscard]] Iterator end() const {
+        return Iterator{ base_.end(), base_.end(), &pred_ };
+    }
+
+private:
+    Base base_;
+    Pred pred_;
+};
+
+// Результаты fn(element) для элементов базового диапазона. fn вызывается при каждом разыменовании
+template <typename Base, typename Fn>
+class TransformView {
+    using BaseIterator = detail::RangeIterator<Base>;
+
+public:
+    class Iterator {
+        friend class TransformView;
+
+        Iterator(BaseIterator it, const Fn* fn)
+            : it_(std::move(it))
+            , fn_(fn) {
+        }
+
+    public:
+        using iterator_category = detail::ViewIteratorCategory<BaseIterator>;
+        using reference = std::invoke_result_t<const Fn&, typename std::iterator_traits<BaseIterator>::reference>;
+        using value_type = std::remove_cv_t<std::remove_reference_t<reference>>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+
+        Iterator() = default;
+
+        [[nodiscard]] bool operator==(const Iterator& rhs) const {
+            return it_ == rhs.it_;
+        }
+
+        [[nodiscard]] bool operator!=(const Iterator& rhs) const {
+            return !(*this == rhs);
+        }
+
+        Iterator& operator++() {
+            ++it_;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto old_value(*this);
+            ++it_;
+            return old_value;
+        }
+
+        [[nodiscard]] reference operator*() const {
+            return (*fn_)(*it_);
+        }
+
+    private:
+        BaseIterator it_{};
+        const Fn* fn_ = nullptr;
+    };
+
+    TransformView(Base base, Fn fn)
+        : base_(std::move(base))
+        , fn_(std::move(fn)) {
+    }
+
+    [[nodiscard]] Iterator begin() const {
+        return Iterator{ base_.begin(), &fn_ };
+    }
+
+    [[nodiscard]] Iterator end() const {
+        return Iterator{ base_.end(), &fn_ };
+    }
+
+private:
+    Base base_;
+    Fn fn_;
+};
+
+// Первые count элементов базового диапазона. Элемент после последнего взятого не запрашивается,
+// поэтому Take останавливает и бесконечный генератор
+template <typename Base>
+class TakeView {
+    using BaseIterator = detail::RangeIterator<Base>;
+
+public:
+    class Iterator {
+        friend class TakeView;
+
+        Iterator(BaseIterator it, BaseIterator last, size_t remaining)
+            : it_(std::move(it))
+            , last_(std::move(last))
+            , remaining_(remaining) {
+        }
+
+    public:
+        using iterator_category = detail::ViewIteratorCategory<BaseIterator>;
+        using value_type = typename std::iterator_traits<BaseIterator>::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = typename std::iterator_traits<BaseIterator>::reference;
+
+        Iterator() = default;
+
+        [[nodiscard]] bool operator==(const Iterator& rhs) const {
+            return IsEnd() == rhs.IsEnd() && (IsEnd() || it_ == rhs.it_);
+        }
+
+        [[nodiscard]] bool operator!=(const Iterator& rhs) const {
+            return !(*this == rhs);
+        }
+
+        Iterator& operator++() {
+            assert(!IsEnd());
+            if (--remaining_ != 0) {
+                ++it_;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto old_value(*this);
+            ++*this;
+            return old_value;
+        }
+
+        [[nodiscard]] reference operator*() const {
+            return *it_;
+        }
+
+    private:
+        [[nodiscard]] bool IsEnd() const {
+            return remaining_ == 0 || it_ == last_;
+        }
+
+        BaseIterator it_{};
+        BaseIterator last_{};
+        size_t remaining_ = 0;
+    };
+
+    TakeView(Base base, size_t count)
+        : base_(std::move(base))
+        , count_(count) {
+    }
+
+    [[nodiscard]] Iterator begin() const {
+        return Iterator{ base_.begin(), base_.end(), count_ };
+    }
+
+    [[nodiscard]] Iterator end() const {
+        return Iterator{ base_.end(), base_.end(), 0 };
+    }
+
+private:
+    Base base_;
+    size_t count_;
+};
+
+template <typename Range>
+class LazyView;
+
+// Последовательные группы по size элементов, последняя может быть короче.
+// Группа - ленивое представление над элементами базового диапазона, без копирования.
+// Базовый диапазон должен быть многопроходным
+template <typename Base>
+class ChunkView {
+    using BaseIterator = detail::RangeIterator<Base>;
+
+    static_assert(detail::IS_FORWARD_ITERATOR<BaseIterator>, "Chunk requires a multi-pass range");
+
+public:
+    using Chunk = LazyView<TakeView<IteratorRange<BaseIterator>>>;
+
+    class Iterator {
+        friend class ChunkView;
+
+        Iterator(BaseIterator it, BaseIterator last, size_t size)
+            : it_(std::move(it))
+            , last_(std::move(last))
+            , size_(size) {
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Chunk;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Chunk;
+
+        Iterator() = default;
+
+        [[nodiscard]] bool operator==(const Iterator& rhs) const {
+            return it_ == rhs.it_;
+        }
+
+        [[nodiscard]] bool operator!=(const Iterator& rhs) const {
+            return !(*this == rhs);
+        }
+
+        Iterator& operator++() {
+            for (size_t i = 0; i < size_ && it_ != last_; ++i) {
+                ++it_;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto old_value(*this);
+            ++*this;
+            return old_value;
+        }
+
+        [[nodiscard]] reference operator*() const {
+            return Chunk{ TakeView<IteratorRange<BaseIterator>>{ IteratorRange<BaseIterator>{ it_, last_ }, size_ } };
+        }
+
+    private:
+        BaseIterator it_{};
+        BaseIterator last_{};
+        size_t size_ = 0;
+    };
+
+    ChunkView(Base base, size_t size)
+        : base_(std::move(base))
+        , size_(size) {
+        assert(size > 0);
+    }
+
+    [[nodiscard]] Iterator begin() const {
+        return Iterator{ base_.begin(), base_.end(), size_ };
+    }
+
+    [[nodiscard]] Iterator end() const {
+        return Iterator{ base_.end(), base_.end(), size_ };
+    }
+
+private:
+    Base base_;
+    size_t size_;
+};
+
+// Пары элементов двух диапазонов с одинаковыми номерами, по длине более короткого диапазона
+template <typename First, typename Second>
+class ZipView {
+    using FirstIterator = detail::RangeIterator<First>;
+    using SecondIterator = detail::RangeIterator<Second>;
+
+public:
+    class Iterator {
+        friend class ZipView;
+
+        Iterator(FirstIterator first, FirstIterator first_last, SecondIterator second, SecondIterator second_last)
+            : first_(std::move(first))
+            , first_last_(std::move(first_last))
+            , second_(std::move(second))
+            , second_last_(std::move(second_last)) {
+        }
+
+    public:
+        using iterator_category = std::conditional_t<
+            detail::IS_FORWARD_ITERATOR<FirstIterator> && detail::IS_FORWARD_ITERATOR<SecondIterator>,
+            std::forward_iterator_tag, std::input_iterator_tag>;
+        using reference = std::pair<typename std::iterator_traits<FirstIterator>::reference,
+                                    typename std::iterator_traits<SecondIterator>::reference>;
+        using value_type = std::pair<typename std::iterator_traits<FirstIterator>::value_type,
+                                     typename std::iterator_traits<SecondIterator>::value_type>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+
+        Iterator() = default;
+
+        [[nodiscard]] bool operator==(const Iterator& rhs) const {
+            return IsEnd() == rhs.IsEnd() && (IsEnd() || (first_ == rhs.first_ && second_ == rhs.second_));
+        }
+
+        [[nodiscard]] bool operator!=(const Iterator& rhs) const {
+            return !(*this == rhs);
+        }
+
+        Iterator& operator++() {
+            ++first_;
+            ++second_;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto old_value(*this);
+            ++*this;
+            return old_value;
+        }
+
+        [[nodiscard]] reference operator*() const {
+            return reference{ *first_, *second_ };
+        }
+
+    private:
+        [[nodiscard]] bool IsEnd() const {
+            return first_ == first_last_ || second_ == second_last_;
+        }
+
+        FirstIterator first_{};
+        FirstIterator first_last_{};
+        SecondIterator second_{};
+        SecondIterator second_last_{};
+    };
+
+    ZipView(First first, Second second)
+        : first_(std::move(first))
+        , second_(std::move(second)) {
+    }
+
+    [[nodiscard]] Iterator begin() const {
+        return Iterator{ first_.begin(), first_.end(), second_.begin(), second_.end() };
+    }
+
+    [[nodiscard]] Iterator end() const {
+        return Iterator{ first_.end(), first_.end(), second_.end(), second_.end() };
+    }
+
+private:
+    First first_;
+    Second second_;
+};
+
+// Цепочка ленивых стадий. Каждый метод возвращает новое представление, исходное не меняется
+template <typename Range>
+class LazyView {
+public:
+    using Iterator = detail::RangeIterator<Range>;
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+
+    explicit LazyView(Range range)
+        : range_(std::move(range)) {
+    }
+
+    [[nodiscard]] Iterator begin() const {
+        return range_.begin();
+    }
+
+    [[nodiscard]] Iterator end() const {
+        return range_.end();
+    }
+
+    template <typename Pred>
+    [[nodiscard]] LazyView<FilterView<Range, Pred>> Filter(Pred pred) const {
+        return LazyView<FilterView<Range, Pred>>{ FilterView<Range, Pred>{ range_, std::move(pred) } };
+    }
+
+    template <typename Fn>
+    [[nodiscard]] LazyView<TransformView<Range, Fn>> Transform(Fn fn) const {
+        return LazyView<TransformView<Range, Fn>>{ TransformView<Range, Fn>{ range_, std::move(fn) } };
+    }
+
+    [[nodiscard]] LazyView<TakeView<Range>> Take(size_t count) const {
+        return LazyView<TakeView<Range>>{ TakeView<Range>{ range_, count } };
+    }
+
+    [[nodiscard]] LazyView<ChunkView<Range>> Chunk(size_t size) const {
+        return LazyView<ChunkView<Range>>{ ChunkView<Range>{ range_, size } };
+    }
+
+    template <typename Other>
+    [[nodiscard]] LazyView<ZipView<Range, Other>> Zip(const LazyView<Other>& other) const {
+        return LazyView<ZipView<Range, Other>>{ ZipView<Range, Other>{ range_, other.range_ } };
+    }
+
+    /*
+     * Строит список из элементов представления в порядке обхода. Это единственная стадия, выделяющая память.
+     * Для многопроходных представлений длина считается заранее отдельным проходом (Filter при этом
+     * вызывает предикат дважды, а Transform не вызывает функцию), и узлы создаются одной пачкой:
+     * с аллокатором, выделяющим участки, как PoolAllocator, - одним блоком памяти.
+     * Однопроходные источники, например Generator, добавляют узлы по одному
+     */
+    template <typename Allocator = std::allocator<value_type>>
+    [[nodiscard]] SingleLinkedList<value_type, Allocator> Collect(const Allocator& alloc = Allocator()) const {
+        return SingleLinkedList<value_type, Allocator>(begin(), end(), alloc);
+    }
+
+private:
+    template <typename>
+    friend class LazyView;
+
+    Range range_;
+};
+
+// Начинает цепочку стадий над range. range не копируется и должен жить, пока представление обходят
+template <typename Range>
+[[nodiscard]] auto Lazy(Range& range) {
+    using Iter = decltype(range.begin());
+    return LazyView<IteratorRange<Iter>>{ IteratorRange<Iter>{ range.begin(), range.end() } };
+}
+
+// Временный диапазон был бы разрушен раньше представления
+template <typename Range>
+void Lazy(const Range&& range) = delete;
+
+#if SINGLE_LINKED_LIST_HAS_GENERATOR
+
+/*
+ * Генератор C++20: сопрограмма, которая выдаёт элементы через co_yield по одному, по мере обхода.
+ * Подходит как источник для Lazy: Lazy(generator).Filter(pred).Take(n).Collect().
+ * Генератор однопроходный, его итераторы - итераторы ввода.
+ * Исключение из тела сопрограммы выбрасывается из begin() или operator++
+ */
+template <typename Type>
+class Generator {
+public:
+    struct promise_type {
+        [[nodiscard]] Generator get_return_object() noexcept {
+            return Generator{ std::coroutine_handle<promise_type>::from_promise(*this) };
+        }
+
+        std::suspend_always initial_suspend() const noexcept {
+            return {};
+        }
+
+        std::suspend_always final_suspend() const noexcept {
+            return {};
+        }
+
+        // Выданное значение живёт в кадре сопрограммы, пока она приостановлена
+        std::suspend_always yield_value(const Type& value) noexcept {
+            current = std::addressof(value);
+            return {};
+        }
+
+        void return_void() const noexcept {
+        }
+
+        void unhandled_exception() noexcept {
+            exception = std::current_exception();
+        }
+
+        // В генераторе нельзя ждать других сопрограмм
+        template <typename Awaitable>
+        std::suspend_never await_transform(Awaitable&&) = delete;
+
+        const Type* current = nullptr;
+        std::exception_ptr exception;
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    class Iterator {
+        friend class Generator;
+
+        explicit Iterator(Handle handle) noexcept
+            : handle_(handle) {
+        }
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Type*;
+        using reference = const Type&;
+
+        Iterator() = default;
+
+        [[nodiscard]] bool operator==(const Iterator& rhs) const noexcept {
+            return IsEnd() == rhs.IsEnd();
+        }
+
+        [[nodiscard]] bool operator!=(const Iterator& rhs) const noexcept {
+            return IsEnd() != rhs.IsEnd();
+        }
+
+        Iterator& operator++() {
+            Resume(handle_);
+            return *this;
+        }
+
+        void operator++(int) {
+            ++*this;
+        }
+
+        [[nodiscard]] reference operator*() const noexcept {
+            assert(!IsEnd());
+            return *handle_.promise().current;
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept {
+            assert(!IsEnd());
+            return handle_.promise().current;
+        }
+
+    private:
+        [[nodiscard]] bool IsEnd() const noexcept {
+            return !handle_ || handle_.done();
+        }
+
+        Handle handle_ = nullptr;
+    };
+
+    Generator(Generator&& other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr)) {
+    }
+
+    Generator& operator=(Generator&& rhs) noexcept {
+        if (this != &rhs) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(rhs.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    ~Generator() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    // Запускает сопрограмму до первого co_yield. Вызывается один раз
+    [[nodiscard]] Iterator begin() {
+        Resume(handle_);
+        return Iterator{ handle_ };
+    }
+
+    [[nodiscard]] Iterator end() noexcept {
+        return Iterator{};
+    }
+
+private:
+    explicit Generator(Handle handle) noexcept
+        : handle_(handle) {
+    }
+
+    static void Resume(Handle handle) {
+        handle.resume();
+        if (handle.done() && handle.promise().exception) {
+            std::rethrow_exception(std::exchange(handle.promise().exception, nullptr));
+        }
+    }
+
+    Handle handle_;
+};
+
+#endif
@@ -1,373 +1,39 @@
 #include <cassert>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <cstddef>
+#include <cstring>
+#include <cstdio>
 #include <iterator>
+#include <memory>
+#include <new>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
 #include <string>
 #include <utility>
 #include <vector>
 
-template <typename Type>
-class SingleLinkedList {
-    // Узел списка
-    struct Node {
-        Node() = default;
-        Node(const Type& val, Node* next)
-            : value(val)
-            , next_node(next) {
-        }
-        Type value;
-        Node* next_node = nullptr;
-    };
-
-    // Шаблон класса Базовый Итератор.
-    // Определяет поведение итератора на элементы односвязного списка
-    // ValueType - совпадает с Type (для Iterator) либо с const Type (для ConstIterator)
-    template <typename ValueType>
-    class BasicIterator {
-        // Класс списка объявляется дружественным, чтобы из методов списка
-        // был доступ к приватной области итератора
-        friend class SingleLinkedList;
-
-        // Конвертирующий конструктор итератора из указателя на узел списка
-        explicit BasicIterator(Node* node) {
-            //assert(false);
-            // Реализуйте конструктор самостоятельно
-            node_ = node;
-        }
-
-    public:
-        // Объявленные ниже типы сообщают стандартной библиотеке о свойствах этого итератора
-
-        // Категория итератора - forward iterator
-        // (итератор, который поддерживает операции инкремента и многократное разыменование)
-        using iterator_category = std::forward_iterator_tag;
-        // Тип элементов, по которым перемещается итератор
-        using value_type = Type;
-        // Тип, используемый для хранения смещения между итераторами
-        using difference_type = std::ptrdiff_t;
-        // Тип указателя на итерируемое значение
-        using pointer = ValueType*;
-        // Тип ссылки на итерируемое значение
-        using reference = ValueType&;
-
-        BasicIterator() = default;
-
-        // Конвертирующий конструктор/конструктор копирования
-        // При ValueType, совпадающем с Type, играет роль копирующего конструктора
-        // При ValueType, совпадающем с const Type, играет роль конвертирующего конструктора
-        BasicIterator(const BasicIterator<Type>& other) noexcept {
-            node_ = other.node_;
-        }
-
-        // Чтобы компилятор не выдавал предупреждение об отсутствии оператора = при наличии
-        // пользовательского конструктора копирования, явно объявим оператор = и
-        // попросим компилятор сгенерировать его за нас.
-        BasicIterator& operator=(const BasicIterator& rhs) = default;
-
-        // Оператор сравнения итераторов (в роли второго аргумента выступает константный итератор)
-        // Два итератора равны, если они ссылаются на один и тот же элемент списка, либо на end()
-        [[nodiscard]] bool operator==(const BasicIterator<const Type>& rhs) const noexcept {
-            return this->node_ == rhs.node_;
-        }
-
-        // Оператор проверки итераторов на неравенство
-        // Противоположен !=
-        [[nodiscard]] bool operator!=(const BasicIterator<const Type>& rhs) const noexcept {
-            return this->node_ != rhs.node_;
-        }
-
-        // Оператор сравнения итераторов (в роли второго аргумента итератор)
-        // Два итератора равны, если они ссылаются на один и тот же элемент списка, либо на end()
-        [[nodiscard]] bool operator==(const BasicIterator<Type>& rhs) const noexcept {
-            return this->node_ == rhs.node_;
-        }
-
-        // Оператор проверки итераторов на неравенство
-        // Противоположен !=
-        [[nodiscard]] bool operator!=(const BasicIterator<Type>& rhs) const noexcept {
-            return this->node_ != rhs.node_;
-        }
-
-        // Оператор прединкремента. После его вызова итератор указывает на следующий элемент списка
-        // Возвращает ссылку на самого себя
-        // Инкремент итератора, не указывающего на существующий элемент списка, приводит к неопределённому поведению
-        BasicIterator& operator++() noexcept {
-            //assert(false);
-            // Заглушка. Реализуйте оператор самостоятельно
-            node_ = node_->next_node;
-            return *this;
-        }
-
-        // Оператор постинкремента. После его вызова итератор указывает на следующий элемент списка.
-        // Возвращает прежнее значение итератора
-        // Инкремент итератора, не указывающего на существующий элемент списка,
-        // приводит к неопределённому поведению
-        BasicIterator operator++(int) noexcept {
-            //assert(false);
-            // Заглушка. Реализуйте оператор самостоятельно
-            auto old_value(*this);
-            node_ = node_->next_node;
-            return old_value;
-        }
-
-        // Операция разыменования. Возвращает ссылку на текущий элемент
-        // Вызов этого оператора у итератора, не указывающего на существующий элемент списка,
-        // приводит к неопределённому поведению
-        [[nodiscard]] reference operator*() const noexcept {
-            return node_->value;
-        }
-
-        // Операция доступа к члену класса. Возвращает указатель на текущий элемент списка.
-        // Вызов этого оператора у итератора, не указывающего на существующий элемент списка,
-        // приводит к неопределённому поведению
-        [[nodiscard]] pointer operator->() const noexcept {
-            assert(node_ != nullptr);
-            return &node_->value;
-        }
-
-    private:
-        Node* node_ = nullptr;
-    };
-
-public:
-    SingleLinkedList() {
-    }
-
-    // Возвращает количество элементов в списке за время O(1)
-    [[nodiscard]] size_t GetSize() const noexcept {
-        // Заглушка. Реализуйте метод самостоятельно
-        return size_;
-        //assert(false);
-        //return 42;
-    }
-
-    // Сообщает, пустой ли список за время O(1)
-    [[nodiscard]] bool IsEmpty() const noexcept {
-        // Заглушка. Реализуйте метод самостоятельно
-        if (size_ != 0) {
-            return false;
-        }
-        return true;
-    }
-
-    // Вставляет элемент value в начало списка за время O(1)
-    void PushFront(const Type& value) {
-        // Реализуйте метод самостоятельно
-        head_.next_node = new Node(value, head_.next_node);
-        ++size_;
-    }
-
-    // Очищает список за время O(N)
-    void Clear() noexcept {
-        // Реализуйте метод самостоятельно
-        while (head_.next_node != nullptr) {
-            Node* new_head = head_.next_node->next_node;
-            delete head_.next_node;
-            head_.next_node = new_head;
-        }
-        size_ = 0;
-    }
-
-    ~SingleLinkedList() {
-        Clear();
-    }
-
-    using value_type = Type;
-    using reference = value_type&;
-    using const_reference = const value_type&;
-
-    // Итератор, допускающий изменение элементов списка
-    using Iterator = BasicIterator<Type>;
-    // Константный итератор, предоставляющий доступ для чтения к элементам списка
-    using ConstIterator = BasicIterator<const Type>;
-
-    // Возвращает итератор, ссылающийся на первый элемент
-    // Если список пустой, возвращённый итератор будет равен end()
-    [[nodiscard]] Iterator begin() noexcept {
-        //assert(false);
-        // Реализуйте самостоятельно
-        return Iterator{ head_.next_node };
-    }
-
-    // Возвращает итератор, указывающий на позицию, следующую за последним элементом односвязного списка
-    // Разыменовывать этот итератор нельзя - попытка разыменования приведёт к неопределённому поведению
-    [[nodiscard]] Iterator end() noexcept {
-        //assert(false);
-        // Реализуйте самостоятельно
-        return Iterator{ nullptr };
-    }
-
-    // Возвращает константный итератор, ссылающийся на первый элемент
-    // Если список пустой, возвращённый итератор будет равен end()
-    // Результат вызова эквивалентен вызову метода cbegin()
-    [[nodiscard]] ConstIterator begin() const noexcept {
-        //assert(false);
-        // Реализуйте самостоятельно
-        return ConstIterator{ head_.next_node };
-    }
-
-    // Возвращает константный итератор, указывающий на позицию, следующую за последним элементом односвязного списка
-    // Разыменовывать этот итератор нельзя - попытка разыменования приведёт к неопределённому поведению
-    // Результат вызова эквивалентен вызову метода cend()
-    [[nodiscard]] ConstIterator end() const noexcept {
-        //assert(false);
-        // Реализуйте самостоятельно
-        return ConstIterator{ nullptr };
-    }
-
-    // Возвращает константный итератор, ссылающийся на первый элемент
-    // Если список пустой, возвращённый итератор будет равен cend()
-    [[nodiscard]] ConstIterator cbegin() const noexcept {
-        //assert(false);
-        // Реализуйте самостоятельно
-        return ConstIterator{ head_.next_node };
-    }
-
-    // Возвращает константный итератор, указывающий на позицию, следующую за последним элементом односвязного списка
-    // Разыменовывать этот итератор нельзя - попытка разыменования приведёт к неопределённому поведению
-    [[nodiscard]] ConstIterator cend() const noexcept {
-        //assert(false);
-        // Реализуйте самостоятельно
-        return ConstIterator{ nullptr };
-    }
-    template<typename Iter>
-    void copy_it(const Iter begin, const Iter end) {
-        SingleLinkedList<Type> temp;
-        Node** back_node = &temp.head_.next_node;
-        for (auto b = begin; b != end; ++b) {
-            *back_node = new Node(*b, nullptr);
-            back_node = &((*back_node)->next_node);
-            ++temp.size_;
-        }
- 
-        swap(temp);
-    }
- 
-    SingleLinkedList(const SingleLinkedList& other) {
-        copy_it(other.begin(), other.end());
-    }
- 
-    SingleLinkedList(const std::initializer_list<Type> i_list) {
-        copy_it(i_list.begin(), i_list.end());
-    }
-
-    SingleLinkedList& operator=(const SingleLinkedList& rhs) {
-        if (this != &rhs){
-            SingleLinkedList rhs2(rhs);
-            swap(rhs2);
-        }
-        return *this;
-    }
-
-    // Обменивает содержимое списков за время O(1)
-    void swap(SingleLinkedList& other) noexcept {
-        std::swap(other.head_.next_node, head_.next_node);
-        std::swap(other.size_, size_);
-    }
-    
-    [[nodiscard]] Iterator before_begin() noexcept {
-        // Реализуйте самостоятельно
-        return Iterator{&head_};
-    }
-
-    // Возвращает константный итератор, указывающий на позицию перед первым элементом односвязного списка.
-    // Разыменовывать этот итератор нельзя - попытка разыменования приведёт к неопределённому поведению
-    [[nodiscard]] ConstIterator cbefore_begin() const noexcept {
-        
-        return ConstIterator{ const_cast<Node*>(&head_) };
-    }
-
-    // Возвращает константный итератор, указывающий на позицию перед первым элементом односвязного списка.
-    // Разыменовывать этот итератор нельзя - попытка разыменования приведёт к неопределённому поведению
-    [[nodiscard]] ConstIterator before_begin() const noexcept {
-        // Реализуйте самостоятельно
-        return cbefore_begin();
-    }
-
-    /*
-     * Вставляет элемент value после элемента, на который указывает pos.
-     * Возвращает итератор на вставленный элемент
-     * Если при создании элемента будет выброшено исключение, список останется в прежнем состоянии
-     */
-    Iterator InsertAfter(ConstIterator pos, const Type& value) {
-        // Заглушка. Реализуйте метод самостоятельно
-        pos.node_->next_node = new Node(value,pos.node_->next_node);
-        ++size_;
-        return Iterator(pos.node_->next_node);
-        
-    }
-
-    void PopFront() noexcept {
-        // Реализуйте метод самостоятельно
-        if(head_.next_node != nullptr){
-        Node* new_head = head_.next_node->next_node;
-        delete head_.next_node;
-        head_.next_node = new_head;
-        --size_;
-        }
-    }
-
-    /*
-     * Удаляет элемент, следующий за pos.
-     * Возвращает итератор на элемент, следующий за удалённым
-     */
-    Iterator EraseAfter(ConstIterator pos) noexcept {
-        
-        if (head_.next_node != nullptr){
-            Node* temp = pos.node_->next_node->next_node;
-            delete(pos.node_->next_node);
-            pos.node_->next_node = temp;
-            --size_;
-        }
-        return Iterator{pos.node_->next_node};
-    }
-    
-private:
-    // Фиктивный узел, используется для вставки "перед первым элементом"
-    Node head_;
-    size_t size_ = 0;
-};
-template <typename Type>
-void swap(SingleLinkedList<Type>& lhs, SingleLinkedList<Type>& rhs) noexcept {
-    lhs.swap(rhs);
-}
-
-template <typename Type>
-bool operator==(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
-    // Заглушка. Реализуйте сравнение самостоятельно
-    //return true;
-    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
-}
-
-template <typename Type>
-bool operator!=(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
-    // Заглушка. Реализуйте сравнение самостоятельно
-    //return true;
-    return !(lhs == rhs);
-}
-
-template <typename Type>
-bool operator<(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
-    // Заглушка. Реализуйте сравнение самостоятельно
-    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
-}
-
-template <typename Type>
-bool operator<=(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
-    // Заглушка. Реализуйте сравнение самостоятельно
-    return !(lhs < rhs);
-}
-
-template <typename Type>
-bool operator>(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
-    // Заглушка. Реализуйте сравнение самостоятельно
-    return rhs < lhs;
-}
-
-template <typename Type>
-bool operator>=(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
-    // Заглушка. Реализуйте сравнение самостоятельно
-    return !(lhs < rhs);
-} 
+#include "background-reclaimer.h"
+#include "compact-single-linked-list.h"
+#include "concurrent-single-linked-list.h"
+#include "hash-indexed-single-linked-list.h"
+#include "indexed-single-linked-list.h"
+#include "intrusive-single-linked-list.h"
+#include "list-serialization.h"
+#include "list-stats.h"
+#include "list-views.h"
+#include "mpsc-queue.h"
+#include "node-pool.h"
+#include "persistent-single-linked-list.h"
+#include "work-stealing-pool.h"
+#include "single-linked-list.h"
+#include "unrolled-linked-list.h"
 
 // Эта функция тестирует работу SingleLinkedList
 void Test1() {
@@ -591,7 +257,2447 @@ void Test2() {
     }
 }
 
+// Эта функция тестирует работу SingleLinkedList с пулом узлов
+void Test3() {
+    using namespace std;
+    using PooledList = SingleLinkedList<string, PoolAllocator<string>>;
+
+    // Узлы берутся из пула и переиспользуются после удаления
+    {
+        PooledList list;
+        list.PushFront("one"s);
+        list.PushFront("two"s);
+        const string* second_node_value = &*list.begin();
+        list.PopFront();
+        list.PushFront("three"s);
+        assert(&*list.begin() == second_node_value);
+        assert(*list.begin() == "three"s);
+        assert(list.GetSize() == 2u);
+
+        list.Clear();
+        assert(list.IsEmpty());
+        for (int i = 0; i < 100; ++i) {
+            list.PushFront(to_string(i));
+        }
+        assert(list.GetSize() == 100u);
+        assert(*list.begin() == "99"s);
+    }
+
+    // Копии списка получают собственный пул, списки с общим пулом не освобождают его целиком
+    {
+        PoolAllocator<string> shared_alloc;
+        PooledList first(shared_alloc);
+        PooledList second(shared_alloc);
+        first.PushFront("a"s);
+        second.PushFront("b"s);
+        first.Clear();
+        assert(*second.begin() == "b"s);
+
+        PooledList copy(second);
+        assert(copy.get_allocator() != second.get_allocator());
+        assert(*copy.begin() == "b"s);
+
+        copy = first;
+        assert(copy.IsEmpty());
+        swap(first, second);
+        assert(*first.begin() == "b"s);
+
+        // Пул копии настроен так же, как пул исходного списка
+        PooledList small_blocks{ PoolAllocator<string>(64) };
+        small_blocks.PushFront("c"s);
+        const PooledList small_copy(small_blocks);
+        assert(small_copy.get_allocator() != small_blocks.get_allocator());
+        assert(small_copy.get_allocator().GetMaxBlockSlots() == 64 && shared_alloc.GetMaxBlockSlots() != 64);
+    }
+}
+
+// Эта функция тестирует перемещение списков и конструирование элементов на месте
+void Test4() {
+    using namespace std;
+
+    // Перемещение списка не копирует элементы
+    {
+        SingleLinkedList<string> list{ "one"s, "two"s };
+        const string* first_value = &*list.begin();
+
+        SingleLinkedList<string> moved(std::move(list));
+        assert(list.IsEmpty());
+        assert(moved.GetSize() == 2u);
+        assert(&*moved.begin() == first_value);
+
+        list.PushFront("three"s);
+        list = std::move(moved);
+        assert(moved.IsEmpty());
+        assert(list.GetSize() == 2u);
+        assert(&*list.begin() == first_value);
+
+        vector<SingleLinkedList<string>> lists;
+        lists.push_back(std::move(list));
+        lists.resize(100);
+        assert(&*lists.front().begin() == first_value);
+    }
+
+    // Вставка rvalue и конструирование на месте
+    {
+        struct NoCopy {
+            NoCopy(int a, int b)
+                : sum(a + b) {
+            }
+            NoCopy(const NoCopy&) = delete;
+            NoCopy& operator=(const NoCopy&) = delete;
+            int sum = 0;
+        };
+
+        SingleLinkedList<NoCopy> list;
+        NoCopy& front = list.EmplaceFront(1, 2);
+        assert(front.sum == 3);
+        auto it = list.EmplaceAfter(list.cbegin(), 3, 4);
+        assert(it->sum == 7);
+        list.EmplaceAfter(list.cbefore_begin(), 0, 0);
+        assert(list.GetSize() == 3u);
+        assert(list.begin()->sum == 0);
+
+        SingleLinkedList<string> strings;
+        string value(100, 'x');
+        const char* buffer = value.data();
+        strings.PushFront(std::move(value));
+        assert(strings.begin()->data() == buffer);
+        string other(100, 'y');
+        buffer = other.data();
+        strings.InsertAfter(strings.cbegin(), std::move(other));
+        assert((++strings.begin())->data() == buffer);
+    }
+}
+
+// Эта функция тестирует вставку в конец и указатель на последний элемент
+void Test5() {
+    // Вставка в конец сохраняет порядок элементов
+    {
+        SingleLinkedList<int> list;
+        list.PushBack(1);
+        list.PushFront(0);
+        list.EmplaceBack(2);
+        assert(list.back() == 2);
+        assert((list == SingleLinkedList<int>{ 0, 1, 2 }));
+
+        list.InsertAfter(++list.cbegin(), 5);
+        list.PushBack(3);
+        assert((list == SingleLinkedList<int>{ 0, 1, 5, 2, 3 }));
+
+        // Удаление последнего элемента сдвигает указатель на конец
+        auto it = list.cbegin();
+        std::advance(it, 3);
+        list.EraseAfter(it);
+        assert(list.back() == 2);
+        list.PushBack(4);
+        assert((list == SingleLinkedList<int>{ 0, 1, 5, 2, 4 }));
+
+        while (!list.IsEmpty()) {
+            list.PopFront();
+        }
+        list.PushBack(7);
+        assert(list.back() == 7);
+        assert(*list.begin() == 7);
+
+        list.Clear();
+        list.PushBack(8);
+        assert(list.GetSize() == 1u && list.back() == 8);
+    }
+
+    // Обмен и копирование сохраняют корректный указатель на конец
+    {
+        SingleLinkedList<int> empty;
+        SingleLinkedList<int> list{ 1, 2 };
+        list.swap(empty);
+        list.PushBack(3);
+        empty.PushBack(4);
+        assert((list == SingleLinkedList<int>{ 3 }));
+        assert((empty == SingleLinkedList<int>{ 1, 2, 4 }));
+
+        SingleLinkedList<int> copy(empty);
+        copy.PushBack(5);
+        assert(copy.back() == 5 && copy.GetSize() == 4u);
+
+        SingleLinkedList<int> moved(std::move(copy));
+        copy.PushBack(6);
+        moved.PushBack(7);
+        assert((copy == SingleLinkedList<int>{ 6 }));
+        assert(moved.back() == 7);
+    }
+
+    // Присоединение другого списка целиком
+    {
+        SingleLinkedList<int> list{ 1, 2 };
+        SingleLinkedList<int> other{ 3, 4 };
+        list.SpliceBack(other);
+        assert(other.IsEmpty());
+        assert(list.back() == 4 && list.GetSize() == 4u);
+        other.PushBack(5);
+        list.SpliceBack(other);
+        assert((list == SingleLinkedList<int>{ 1, 2, 3, 4, 5 }));
+
+        SingleLinkedList<int, PoolAllocator<int>> pooled{ 1 };
+        SingleLinkedList<int, PoolAllocator<int>> other_pooled{ 2, 3 };
+        pooled.SpliceBack(other_pooled);
+        assert(other_pooled.IsEmpty());
+        assert(pooled.GetSize() == 3u && pooled.back() == 3);
+    }
+}
+
+// Эта функция тестирует работу UnrolledLinkedList
+void Test6() {
+    using namespace std;
+
+    // Итерирование и вставка через границы блоков
+    {
+        UnrolledLinkedList<int, 4> list;
+        assert(list.begin() == list.end());
+        for (int i = 0; i < 10; ++i) {
+            list.PushBack(i);
+        }
+        list.PushFront(-1);
+        assert(list.GetSize() == 11u);
+        assert((list == UnrolledLinkedList<int, 4>{ -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+
+        auto it = list.InsertAfter(list.cbegin(), 100);
+        assert(*it == 100);
+        assert(*++it == 0);
+        it = list.EraseAfter(list.cbefore_begin());
+        assert(*it == 100);
+        assert(*list.begin() == 100);
+    }
+
+    // Сравнение со списком-образцом на случайных операциях
+    {
+        mt19937 generator(42);
+        UnrolledLinkedList<string, 3> list;
+        vector<string> model;
+        for (int step = 0; step < 5000; ++step) {
+            const size_t pos = model.empty() ? 0 : generator() % (model.size() + 1);
+            auto it = list.cbefore_begin();
+            for (size_t i = 0; i < pos; ++i) {
+                ++it;
+            }
+            if (generator() % 3 != 0 || pos == model.size()) {
+                const string value = to_string(step);
+                auto inserted = list.InsertAfter(it, value);
+                assert(*inserted == value);
+                model.insert(model.begin() + static_cast<ptrdiff_t>(pos), value);
+            } else {
+                auto next = list.EraseAfter(it);
+                model.erase(model.begin() + static_cast<ptrdiff_t>(pos));
+                assert(next == list.end() || *next == model[pos]);
+            }
+            assert(list.GetSize() == model.size());
+        }
+        assert(equal(list.begin(), list.end(), model.begin(), model.end()));
+
+        UnrolledLinkedList<string, 3> copy(list);
+        assert(copy == list);
+        copy.PushBack("z"s);
+        assert(list < copy && copy > list && list <= copy && copy >= list);
+        copy.Clear();
+        assert(copy.IsEmpty() && copy < list);
+        while (!list.IsEmpty()) {
+            list.PopFront();
+        }
+        list.PushBack("a"s);
+        assert(*list.begin() == "a"s);
+    }
+
+    // Сравнение списков с разными границами блоков
+    {
+        UnrolledLinkedList<int, 4> lhs{ 1, 2, 3, 4, 5, 6 };
+        UnrolledLinkedList<int, 4> rhs;
+        for (int i = 6; i >= 1; --i) {
+            rhs.PushFront(i);
+        }
+        assert(lhs == rhs);
+        *++rhs.begin() = 0;
+        assert(rhs < lhs && lhs != rhs);
+        assert(lhs <= lhs && lhs >= lhs);
+    }
+
+    // Исключение при перемещении элементов в новый блок не теряет ни блок, ни элементы
+    {
+        struct ThrowOnMove {
+            ThrowOnMove(int value, int& moves_left, int& alive)
+                : value(value)
+                , moves_left(&moves_left)
+                , alive(&alive) {
+                ++*this->alive;
+            }
+
+            ThrowOnMove(ThrowOnMove&& other)
+                : value(other.value)
+                , moves_left(other.moves_left)
+                , alive(other.alive) {
+                if (--*moves_left < 0) {
+                    throw runtime_error("move failed");
+                }
+                ++*alive;
+            }
+
+            ThrowOnMove& operator=(ThrowOnMove&& rhs) {
+                if (--*moves_left < 0) {
+                    throw runtime_error("move failed");
+                }
+                value = rhs.value;
+                return *this;
+            }
+
+            ~ThrowOnMove() {
+                --*alive;
+            }
+
+            int value;
+            int* moves_left;
+            int* alive;
+        };
+
+        int moves_left = 1'000;
+        int alive = 0;
+        {
+            UnrolledLinkedList<ThrowOnMove, 4> list;
+            for (int i = 0; i < 4; ++i) {
+                list.EmplaceAfter(i == 0 ? list.cbefore_begin() : next(list.cbegin(), i - 1), i, moves_left, alive);
+            }
+            assert(alive == 4);
+            // Второе перемещение в новый блок при делении заполненного блока выбрасывает исключение
+            moves_left = 1;
+            try {
+                list.EmplaceAfter(list.cbegin(), 10, moves_left, alive);
+                assert(false);
+            } catch (const runtime_error&) {
+            }
+            moves_left = 1'000;
+            assert(alive == 4 && list.GetSize() == 4);
+            int expected = 0;
+            for (const ThrowOnMove& element : list) {
+                assert(element.value == expected++);
+            }
+            list.EmplaceAfter(list.cbegin(), 10, moves_left, alive);
+            assert(alive == 5 && list.GetSize() == 5 && next(list.begin())->value == 10);
+
+            // Исключение при сдвиге элементов незаполненного блока разрушает добавленное место
+            UnrolledLinkedList<ThrowOnMove, 4> partial;
+            for (int i = 0; i < 3; ++i) {
+                partial.EmplaceAfter(i == 0 ? partial.cbefore_begin() : next(partial.cbegin(), i - 1), i, moves_left, alive);
+            }
+            assert(alive == 8);
+            moves_left = 1;
+            try {
+                partial.EmplaceAfter(partial.cbegin(), 10, moves_left, alive);
+                assert(false);
+            } catch (const runtime_error&) {
+            }
+            moves_left = 1'000;
+            assert(alive == 8 && partial.GetSize() == 3 && distance(partial.begin(), partial.end()) == 3);
+        }
+        assert(alive == 0);
+    }
+}
+
+// Эта функция тестирует вставку и создание списка из диапазонов
+void Test7() {
+    using namespace std;
+
+    // Создание и присваивание из диапазонов
+    {
+        const vector<int> values{ 1, 2, 3 };
+        SingleLinkedList<int> list(values.begin(), values.end());
+        assert((list == SingleLinkedList<int>{ 1, 2, 3 }));
+        assert(list.back() == 3);
+
+        SingleLinkedList<int> copies(3u, 7);
+        assert((copies == SingleLinkedList<int>{ 7, 7, 7 }));
+
+        list.Assign(2u, 5);
+        assert((list == SingleLinkedList<int>{ 5, 5 }));
+        istringstream input("4 5 6");
+        list.Assign(istream_iterator<int>(input), istream_iterator<int>());
+        assert((list == SingleLinkedList<int>{ 4, 5, 6 }));
+        assert(list.back() == 6);
+    }
+
+    // Вставка диапазона в середину и в конец
+    {
+        SingleLinkedList<int> list{ 1, 5 };
+        const int middle[] = { 2, 3, 4 };
+        auto last = list.InsertAfter(list.cbegin(), begin(middle), end(middle));
+        assert(*last == 4);
+        assert((list == SingleLinkedList<int>{ 1, 2, 3, 4, 5 }));
+
+        last = list.InsertAfter(last, begin(middle), begin(middle));
+        assert(*last == 4);
+        assert(list.GetSize() == 5u);
+
+        auto back = list.cbegin();
+        advance(back, 4);
+        list.InsertAfter(back, 2u, 6);
+        assert(list.back() == 6 && list.GetSize() == 7u);
+    }
+
+    // Узлы пакета выделяются из пула подряд
+    {
+        SingleLinkedList<int, PoolAllocator<int>> list;
+        list.PushFront(0);
+        const vector<int> values(1000, 1);
+        list.InsertAfter(list.cbegin(), values.begin(), values.end());
+        assert(list.GetSize() == 1001u);
+
+        auto it = ++list.begin();
+        const char* prev = reinterpret_cast<const char*>(&*it);
+        ptrdiff_t stride = 0;
+        for (++it; it != list.end(); ++it) {
+            const char* current = reinterpret_cast<const char*>(&*it);
+            if (stride == 0) {
+                stride = current - prev;
+            }
+            assert(current - prev == stride);
+            prev = current;
+        }
+    }
+
+    // Исключение при создании пакета не меняет список
+    {
+        struct ThrowOnCopy {
+            ThrowOnCopy() = default;
+            explicit ThrowOnCopy(int& copy_counter) noexcept
+                : countdown_ptr(&copy_counter) {
+            }
+            ThrowOnCopy(const ThrowOnCopy& other)
+                : countdown_ptr(other.countdown_ptr) {
+                if (countdown_ptr) {
+                    if (*countdown_ptr == 0) {
+                        throw bad_alloc();
+                    }
+                    --(*countdown_ptr);
+                }
+            }
+            ThrowOnCopy& operator=(const ThrowOnCopy& rhs) = delete;
+            int* countdown_ptr = nullptr;
+        };
+
+        int copy_counter = 100;
+        const vector<ThrowOnCopy> values(5, ThrowOnCopy(copy_counter));
+        copy_counter = 3;
+        SingleLinkedList<ThrowOnCopy, PoolAllocator<ThrowOnCopy>> list;
+        list.PushFront(ThrowOnCopy{});
+        try {
+            list.InsertAfter(list.cbegin(), values.begin(), values.end());
+            assert(false);
+        } catch (const bad_alloc&) {
+            assert(list.GetSize() == 1u);
+        }
+        list.PushBack(ThrowOnCopy{});
+        assert(list.GetSize() == 2u);
+    }
+}
+
+// Эта функция тестирует перенос узлов между списками
+void Test8() {
+    using namespace std;
+
+    // Перенос всего списка, одного элемента и интервала
+    {
+        SingleLinkedList<string> list{ "a"s, "d"s };
+        SingleLinkedList<string> other{ "b"s, "c"s };
+        const string* b_address = &*other.begin();
+
+        list.SpliceAfter(list.cbegin(), other);
+        assert(other.IsEmpty());
+        assert((list == SingleLinkedList<string>{ "a"s, "b"s, "c"s, "d"s }));
+        assert(&*++list.begin() == b_address);
+
+        other.PushBack("x"s);
+        other.PushBack("y"s);
+        list.SpliceAfter(list.cbefore_begin(), other, other.cbegin());
+        assert((list == SingleLinkedList<string>{ "y"s, "a"s, "b"s, "c"s, "d"s }));
+        assert(other.GetSize() == 1u && other.back() == "x"s);
+
+        auto first = list.cbegin();
+        auto last = first;
+        advance(last, 3);
+        other.SpliceAfter(other.cbegin(), list, first, last);
+        assert((other == SingleLinkedList<string>{ "x"s, "a"s, "b"s }));
+        assert(other.back() == "b"s);
+        assert((list == SingleLinkedList<string>{ "y"s, "c"s, "d"s }));
+
+        // Перенос хвоста внутри одного списка обновляет указатель на конец
+        auto c_pos = ++list.cbegin();
+        list.SpliceAfter(list.cbefore_begin(), list, c_pos, list.cend());
+        assert((list == SingleLinkedList<string>{ "d"s, "y"s, "c"s }));
+        assert(list.back() == "c"s);
+        list.PushBack("e"s);
+        assert(list.GetSize() == 4u);
+    }
+
+    // Отделение хвоста списка
+    {
+        SingleLinkedList<int> list{ 1, 2, 3, 4 };
+        auto rest = list.SplitAfter(++list.cbegin());
+        assert((list == SingleLinkedList<int>{ 1, 2 }));
+        assert((rest == SingleLinkedList<int>{ 3, 4 }));
+        list.PushBack(5);
+        rest.PushBack(6);
+        assert(list.back() == 5 && rest.back() == 6);
+
+        auto all = list.SplitAfter(list.cbefore_begin());
+        assert(list.IsEmpty() && all.GetSize() == 3u);
+        assert(list.SplitAfter(list.cbefore_begin()).IsEmpty());
+    }
+
+    // Списки с разными пулами обмениваются элементами через перемещение
+    {
+        SingleLinkedList<int, PoolAllocator<int>> list{ 1, 4 };
+        SingleLinkedList<int, PoolAllocator<int>> other{ 2, 3 };
+        list.SpliceAfter(list.cbegin(), other);
+        assert(other.IsEmpty());
+        assert((list == SingleLinkedList<int, PoolAllocator<int>>{ 1, 2, 3, 4 }));
+
+        PoolAllocator<int> shared_pool;
+        SingleLinkedList<int, PoolAllocator<int>> first(shared_pool);
+        SingleLinkedList<int, PoolAllocator<int>> second(shared_pool);
+        first.PushBack(1);
+        second.PushBack(2);
+        const int* address = &*second.begin();
+        first.SpliceBack(second);
+        assert(&first.back() == address);
+    }
+}
+
+// Эта функция тестирует алгоритмы, переставляющие узлы списка
+void Test9() {
+    using namespace std;
+
+    // Сортировка сохраняет узлы и устойчива
+    {
+        mt19937 generator(7);
+        vector<pair<int, int>> model;
+        SingleLinkedList<pair<int, int>> list;
+        for (int i = 0; i < 1000; ++i) {
+            model.emplace_back(static_cast<int>(generator() % 50), i);
+            list.PushBack(model.back());
+        }
+        const auto* first_address = &*list.begin();
+        const auto by_key = [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        };
+        list.Sort(by_key);
+        stable_sort(model.begin(), model.end(), by_key);
+        assert(equal(list.begin(), list.end(), model.begin(), model.end()));
+        assert(list.back() == model.back());
+        bool node_kept = false;
+        for (const auto& value : list) {
+            node_kept = node_kept || &value == first_address;
+        }
+        assert(node_kept);
+
+        SingleLinkedList<int> empty;
+        empty.Sort();
+        SingleLinkedList<int> small{ 3, 1, 2 };
+        small.Sort();
+        assert((small == SingleLinkedList<int>{ 1, 2, 3 }));
+        small.PushBack(4);
+        assert(small.back() == 4);
+    }
+
+    // При исключении в компараторе элементы остаются в списке
+    {
+        SingleLinkedList<int> list{ 5, 4, 3, 2, 1, 0 };
+        int comparisons = 0;
+        try {
+            list.Sort([&comparisons](int lhs, int rhs) {
+                if (++comparisons == 5) {
+                    throw runtime_error("comparison failed");
+                }
+                return lhs < rhs;
+            });
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        assert(list.GetSize() == 6u);
+        list.Sort();
+        assert((list == SingleLinkedList<int>{ 0, 1, 2, 3, 4, 5 }));
+        assert(list.back() == 5);
+    }
+
+    // Разворот, удаление повторов и удаление по условию
+    {
+        SingleLinkedList<int> list{ 1, 1, 2, 3, 3, 3, 4 };
+        list.Reverse();
+        assert((list == SingleLinkedList<int>{ 4, 3, 3, 3, 2, 1, 1 }));
+        assert(list.back() == 1);
+        assert(list.Unique() == 3u);
+        assert((list == SingleLinkedList<int>{ 4, 3, 2, 1 }));
+        assert(list.RemoveIf([](int value) {
+            return value % 2 == 1;
+        }) == 2u);
+        assert((list == SingleLinkedList<int>{ 4, 2 }));
+        assert(list.back() == 2);
+        list.PushBack(0);
+        assert(list.GetSize() == 3u);
+    }
+
+    // Слияние отсортированных списков
+    {
+        SingleLinkedList<int> list{ 1, 3, 5 };
+        SingleLinkedList<int> other{ 0, 2, 4, 6, 7 };
+        list.Merge(other);
+        assert(other.IsEmpty());
+        assert((list == SingleLinkedList<int>{ 0, 1, 2, 3, 4, 5, 6, 7 }));
+        assert(list.back() == 7);
+
+        SingleLinkedList<int> tail{ 8 };
+        other.PushBack(-1);
+        list.Merge(tail);
+        list.Merge(other);
+        assert(list.GetSize() == 10u);
+        assert(*list.begin() == -1 && list.back() == 8);
+
+        SingleLinkedList<int, PoolAllocator<int>> pooled{ 2 };
+        SingleLinkedList<int, PoolAllocator<int>> other_pooled{ 1, 3 };
+        pooled.Merge(other_pooled);
+        assert((pooled == SingleLinkedList<int, PoolAllocator<int>>{ 1, 2, 3 }));
+    }
+}
+
+// Эта функция тестирует работу ConcurrentSingleLinkedList
+void Test10() {
+    using namespace std;
+
+    // Однопоточная работа в режиме стека
+    {
+        ConcurrentSingleLinkedList<string> stack;
+        assert(stack.IsEmpty());
+        assert(!stack.TryPopFront());
+        stack.PushFront("one"s);
+        stack.EmplaceFront(3, 'x');
+        assert(stack.GetSize() == 2u);
+        assert(*stack.TryPopFront() == "xxx"s);
+        stack.PopFront();
+        assert(stack.IsEmpty() && stack.GetSize() == 0u);
+        for (int i = 0; i < 1000; ++i) {
+            stack.PushFront(to_string(i));
+        }
+        assert(*stack.TryPopFront() == "999"s);
+    }
+
+    // Каждый элемент, помещённый производителями, извлекается ровно один раз
+    {
+        constexpr int THREAD_COUNT = 4;
+        constexpr int ITEMS_PER_THREAD = 20000;
+        ConcurrentSingleLinkedList<int> stack;
+        vector<vector<int>> popped(THREAD_COUNT);
+        atomic<int> finished_producers{ 0 };
+
+        vector<thread> threads;
+        for (int t = 0; t < THREAD_COUNT; ++t) {
+            threads.emplace_back([&stack, &finished_producers, t] {
+                for (int i = 0; i < ITEMS_PER_THREAD; ++i) {
+                    stack.PushFront(t * ITEMS_PER_THREAD + i);
+                }
+                ++finished_producers;
+            });
+            threads.emplace_back([&stack, &finished_producers, &popped, t] {
+                while (true) {
+                    const bool producers_done = finished_producers == THREAD_COUNT;
+                    if (auto value = stack.TryPopFront()) {
+                        popped[t].push_back(*value);
+                    } else if (producers_done) {
+                        break;
+                    }
+                }
+            });
+        }
+        for (auto& worker : threads) {
+            worker.join();
+        }
+
+        vector<int> all;
+        for (const auto& part : popped) {
+            all.insert(all.end(), part.begin(), part.end());
+        }
+        sort(all.begin(), all.end());
+        assert(all.size() == static_cast<size_t>(THREAD_COUNT * ITEMS_PER_THREAD));
+        for (size_t i = 0; i < all.size(); ++i) {
+            assert(all[i] == static_cast<int>(i));
+        }
+        assert(stack.IsEmpty() && stack.GetSize() == 0u);
+    }
+
+    // Оставшиеся в списке элементы разрушаются вместе с ним
+    {
+        int counter = 0;
+        struct Counted {
+            explicit Counted(int& instances)
+                : instances_ptr(&instances) {
+                ++*instances_ptr;
+            }
+            Counted(const Counted& other)
+                : instances_ptr(other.instances_ptr) {
+                ++*instances_ptr;
+            }
+            ~Counted() {
+                --*instances_ptr;
+            }
+            int* instances_ptr;
+        };
+        {
+            ConcurrentSingleLinkedList<Counted> stack;
+            for (int i = 0; i < 100; ++i) {
+                stack.EmplaceFront(counter);
+            }
+            stack.PopFront();
+            assert(counter == 99);
+        }
+        assert(counter == 0);
+    }
+}
+
+// Эта функция тестирует сбор статистики списка
+void Test11() {
+    using namespace std;
+    using CountedList = SingleLinkedList<int, allocator<int>, ListStats>;
+
+    // Выключенная статистика не увеличивает размер списка
+    static_assert(sizeof(SingleLinkedList<int>) == sizeof(SingleLinkedList<int, allocator<int>, NoListStats>));
+
+    {
+        CountedList list;
+        list.PushFront(1);
+        list.PushBack(2);
+        list.InsertAfter(list.cbegin(), 3u, 0);
+        auto snapshot = list.GetStats().Snapshot();
+        assert(snapshot.allocations == 5u);
+        assert(snapshot.peak_size == 5u);
+
+        list.PopFront();
+        list.EraseAfter(list.cbefore_begin());
+        snapshot = list.GetStats().Snapshot();
+        assert(snapshot.frees == 2u);
+
+        CountedList other{ 7, 8, 9, 10, 11, 12 };
+        list = other;
+        snapshot = list.GetStats().Snapshot();
+        assert(snapshot.copies == 6u);
+        assert(snapshot.allocations == 11u);
+        assert(snapshot.frees == 5u);
+        assert(snapshot.peak_size == 6u);
+        assert(snapshot.operation_counts[static_cast<size_t>(ListOperation::COPY)] == 1u);
+
+        list.SpliceAfter(list.cbegin(), other);
+        list.Sort();
+        list.Clear();
+        snapshot = list.GetStats().Snapshot();
+        assert(snapshot.splices == 1u);
+        assert(snapshot.peak_size == 12u);
+        assert(snapshot.frees == 17u);
+        assert(snapshot.operation_counts[static_cast<size_t>(ListOperation::SORT)] == 1u);
+        assert(snapshot.operation_counts[static_cast<size_t>(ListOperation::CLEAR)] == 1u);
+    }
+}
+
+// Эта функция тестирует фиктивный узел без значения
+void Test12() {
+    using namespace std;
+
+    // Элемент без конструктора по умолчанию, который считает живые объекты
+    struct Counted {
+        Counted(int v, int& counter)
+            : value(v)
+            , alive(&counter) {
+            ++*alive;
+        }
+        Counted(const Counted& other)
+            : value(other.value)
+            , alive(other.alive) {
+            ++*alive;
+        }
+        ~Counted() {
+            --*alive;
+        }
+        bool operator<(const Counted& rhs) const {
+            return value < rhs.value;
+        }
+        int value;
+        int* alive;
+    };
+    static_assert(!is_default_constructible_v<Counted>);
+    int alive = 0;
+
+    // Пустой список не создаёт ни одного элемента
+    {
+        SingleLinkedList<Counted> list;
+        assert(alive == 0);
+        SingleLinkedList<Counted> lists[100];
+        assert(alive == 0);
+
+        list.EmplaceFront(3, alive);
+        list.EmplaceBack(1, alive);
+        list.EmplaceAfter(list.cbegin(), 2, alive);
+        assert(alive == 3);
+        list.Sort();
+        assert(list.begin()->value == 1 && list.back().value == 3);
+
+        SingleLinkedList<Counted> copy(list);
+        assert(alive == 6);
+        lists[0] = std::move(copy);
+        lists[0].Reverse();
+        assert(lists[0].begin()->value == 3);
+        assert(alive == 6);
+    }
+    assert(alive == 0);
+
+    // Фиктивный узел - это один указатель, аллокатор без состояния места не занимает
+    static_assert(sizeof(SingleLinkedList<Counted>) == 3 * sizeof(void*));
+    static_assert(sizeof(SingleLinkedList<array<char, 4096>>) == 3 * sizeof(void*));
+
+    // Аллокатор с состоянием продолжает работать
+    {
+        PoolAllocator<Counted> pool;
+        SingleLinkedList<Counted, PoolAllocator<Counted>> list(pool);
+        for (int i = 0; i < 10; ++i) {
+            list.EmplaceFront(i, alive);
+        }
+        assert(list.get_allocator() == pool);
+        SingleLinkedList<Counted, PoolAllocator<Counted>> other;
+        other.SpliceAfter(other.cbefore_begin(), list);
+        assert(list.IsEmpty() && other.GetSize() == 10u);
+    }
+    assert(alive == 0);
+}
+
+// Аллокатор, считающий выделения памяти. Все копии аллокатора равны
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    explicit CountingAllocator(size_t& counter) noexcept
+        : allocations(&counter) {
+    }
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other) noexcept
+        : allocations(other.allocations) {
+    }
+
+    T* allocate(size_t n) {
+        ++*allocations;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>&) const noexcept {
+        return false;
+    }
+
+    size_t* allocations;
+};
+
+// Эта функция тестирует встроенные в список узлы
+void Test13() {
+    using namespace std;
+    using Small = SingleLinkedList<string, CountingAllocator<string>, NoListStats, 4>;
+
+    const auto to_vector = [](const Small& list) {
+        return vector<string>(list.begin(), list.end());
+    };
+
+    // Первые узлы не выделяют память
+    {
+        size_t allocations = 0;
+        CountingAllocator<string> alloc(allocations);
+        Small list(alloc);
+        for (int i = 0; i < 4; ++i) {
+            list.PushFront(to_string(i));
+        }
+        assert(allocations == 0);
+        list.PushBack("4"s);
+        assert(allocations == 1);
+        assert((to_vector(list) == vector<string>{ "3", "2", "1", "0", "4" }));
+
+        list.EraseAfter(list.cbefore_begin());
+        list.PopFront();
+        list.InsertAfter(list.cbegin(), "x"s);
+        list.EmplaceFront(3, 'y');
+        assert(allocations == 1);
+        assert((to_vector(list) == vector<string>{ "yyy", "1", "x", "0", "4" }));
+
+        list.Clear();
+        list.Assign(4, "z"s);
+        assert(allocations == 1);
+    }
+
+    // Обмен и перемещение переносят значения встроенных узлов, не выделяя память
+    {
+        size_t allocations = 0;
+        CountingAllocator<string> alloc(allocations);
+        for (size_t lhs_size : { 0, 1, 3, 4, 6 }) {
+            for (size_t rhs_size : { 0, 2, 4, 7 }) {
+                Small lhs(alloc);
+                Small rhs(alloc);
+                vector<string> lhs_values;
+                vector<string> rhs_values;
+                for (size_t i = 0; i < lhs_size; ++i) {
+                    lhs_values.push_back(string(20, 'a') + to_string(i));
+                }
+                for (size_t i = 0; i < rhs_size; ++i) {
+                    rhs_values.push_back(string(20, 'b') + to_string(i));
+                }
+                lhs.Assign(lhs_values.begin(), lhs_values.end());
+                rhs.Assign(rhs_values.begin(), rhs_values.end());
+                // Встроенные узлы оказываются в конце списка
+                lhs.Reverse();
+                rhs.Reverse();
+                reverse(lhs_values.begin(), lhs_values.end());
+                reverse(rhs_values.begin(), rhs_values.end());
+
+                const size_t before = allocations;
+                lhs.swap(rhs);
+                assert(allocations == before);
+                assert(to_vector(lhs) == rhs_values);
+                assert(to_vector(rhs) == lhs_values);
+                lhs.PushBack("tail"s);
+                rhs_values.push_back("tail");
+                assert(lhs.back() == "tail");
+
+                Small moved(std::move(lhs));
+                assert(lhs.IsEmpty());
+                assert(to_vector(moved) == rhs_values);
+                rhs = std::move(moved);
+                assert(to_vector(rhs) == rhs_values);
+                lhs = rhs;
+                assert(to_vector(lhs) == rhs_values);
+            }
+        }
+    }
+
+    // Перенос узлов между списками
+    {
+        size_t allocations = 0;
+        CountingAllocator<string> alloc(allocations);
+        Small lhs({ "1"s, "3"s, "5"s }, alloc);
+        Small rhs({ "2"s, "4"s, "6"s, "8"s, "9"s }, alloc);
+
+        lhs.Merge(rhs);
+        assert(rhs.IsEmpty());
+        assert((to_vector(lhs) == vector<string>{ "1", "2", "3", "4", "5", "6", "8", "9" }));
+        assert(lhs.back() == "9");
+
+        Small tail = lhs.SplitAfter(lhs.cbegin());
+        assert((to_vector(lhs) == vector<string>{ "1" }));
+        assert((to_vector(tail) == vector<string>{ "2", "3", "4", "5", "6", "8", "9" }));
+        assert(tail.back() == "9");
+
+        lhs.SpliceAfter(lhs.cbefore_begin(), tail, tail.cbegin(), tail.cend());
+        assert((to_vector(lhs) == vector<string>{ "3", "4", "5", "6", "8", "9", "1" }));
+        assert((to_vector(tail) == vector<string>{ "2" }));
+        assert(lhs.back() == "1");
+
+        vector<string> values{ "a", "b", "c", "d", "e" };
+        tail.InsertAfter(tail.cbefore_begin(), values.begin(), values.end());
+        tail.SpliceBack(lhs);
+        assert(lhs.IsEmpty());
+        tail.Sort();
+        assert((to_vector(tail) == vector<string>{ "1", "2", "3", "4", "5", "6", "8", "9", "a", "b", "c", "d", "e" }));
+        assert(tail.back() == "e");
+    }
+
+    // Случайные операции над парой списков сверяются с векторами
+    {
+        size_t allocations = 0;
+        CountingAllocator<string> alloc(allocations);
+        Small lists[2] = { Small(alloc), Small(alloc) };
+        vector<string> models[2];
+        mt19937 generator(12);
+        for (int step = 0; step < 20000; ++step) {
+            const size_t i = generator() % 2;
+            Small& list = lists[i];
+            vector<string>& model = models[i];
+            const size_t pos = model.empty() ? 0 : generator() % (model.size() + 1);
+            auto it = list.cbefore_begin();
+            for (size_t k = 0; k < pos; ++k) {
+                ++it;
+            }
+            switch (generator() % 7) {
+                case 0:
+                case 1: {
+                    const string value = to_string(step);
+                    list.InsertAfter(it, value);
+                    model.insert(model.begin() + pos, value);
+                    break;
+                }
+                case 2:
+                    if (pos < model.size()) {
+                        list.EraseAfter(it);
+                        model.erase(model.begin() + pos);
+                    }
+                    break;
+                case 3:
+                    lists[0].swap(lists[1]);
+                    models[0].swap(models[1]);
+                    break;
+                case 4: {
+                    Small rest = list.SplitAfter(it);
+                    Small& other = lists[1 - i];
+                    other.SpliceAfter(other.cbefore_begin(), rest);
+                    models[1 - i].insert(models[1 - i].begin(), model.begin() + pos, model.end());
+                    model.erase(model.begin() + pos, model.end());
+                    break;
+                }
+                case 5:
+                    if (model.size() > 8) {
+                        list.Clear();
+                        model.clear();
+                    }
+                    break;
+                case 6:
+                    list = Small(lists[1 - i]);
+                    model = models[1 - i];
+                    break;
+            }
+            for (size_t k = 0; k < 2; ++k) {
+                assert(to_vector(lists[k]) == models[k]);
+                assert(lists[k].GetSize() == models[k].size());
+                assert(models[k].empty() || lists[k].back() == models[k].back());
+            }
+        }
+    }
+
+    // Без встроенных узлов размер списка не меняется
+    static_assert(sizeof(SingleLinkedList<string, allocator<string>, NoListStats, 0>) == 3 * sizeof(void*));
+    static_assert(sizeof(SmallSingleLinkedList<int, 4>) > sizeof(SingleLinkedList<int>));
+}
+
+// Эта функция тестирует быструю и фоновую очистку списка
+void Test14() {
+    using namespace std;
+
+    // Тривиально разрушаемые элементы возвращаются в общий пул одной цепочкой
+    {
+        PoolAllocator<int> pool;
+        SingleLinkedList<int, PoolAllocator<int>, ListStats> list(pool);
+        for (int i = 0; i < 1000; ++i) {
+            list.PushFront(i);
+        }
+        const int* first = &*list.begin();
+        list.Clear();
+        assert(list.IsEmpty());
+        assert(list.begin() == list.end());
+        assert(list.GetStats().Snapshot().frees == 1000u);
+
+        // Пул снова раздаёт узлы цепочки, начиная с её первого узла
+        list.PushFront(1);
+        assert(&*list.begin() == first);
+        for (int i = 0; i < 2000; ++i) {
+            list.PushBack(i);
+        }
+        assert(list.GetSize() == 2001u);
+        assert(list.back() == 1999);
+    }
+
+    // Пул, принадлежащий только списку, освобождается блоками
+    {
+        SingleLinkedList<int, PoolAllocator<int>> list;
+        for (int i = 0; i < 1000; ++i) {
+            list.PushFront(i);
+        }
+        list.Clear();
+        list.PushFront(1);
+        assert(list.GetSize() == 1u);
+    }
+
+    // Фоновая очистка разрушает элементы в другом потоке
+    {
+        int item_counter = 0;
+        {
+            struct Counted {
+                explicit Counted(int& counter)
+                    : counter_ptr(&counter) {
+                    ++*counter_ptr;
+                }
+                Counted(const Counted& other)
+                    : counter_ptr(other.counter_ptr) {
+                    ++*counter_ptr;
+                }
+                ~Counted() {
+                    --*counter_ptr;
+                }
+                int* counter_ptr;
+            };
+
+            SingleLinkedList<Counted, allocator<Counted>, ListStats> list;
+            for (int i = 0; i < 100; ++i) {
+                list.EmplaceFront(item_counter);
+            }
+            list.ClearAsync();
+            assert(list.IsEmpty());
+            assert(list.GetStats().Snapshot().frees == 100u);
+            BackgroundReclaimer::Instance().Flush();
+            assert(item_counter == 0);
+
+            list.EmplaceFront(item_counter);
+            list.EmplaceBack(item_counter);
+            assert(list.GetSize() == 2u);
+            list.ClearAsync();
+        }
+        BackgroundReclaimer::Instance().Flush();
+        assert(item_counter == 0);
+    }
+
+    // Списки с пулом и со встроенными узлами очищаются сразу
+    {
+        SingleLinkedList<string, PoolAllocator<string>> pooled{ "a"s, "b"s };
+        pooled.ClearAsync();
+        assert(pooled.IsEmpty());
+
+        SmallSingleLinkedList<string, 2> small{ "a"s, "b"s, "c"s };
+        small.ClearAsync();
+        assert(small.IsEmpty());
+        small.PushFront("d"s);
+        assert(small.GetSize() == 1u);
+    }
+}
+
+// Эта функция тестирует уплотнение узлов и обход с предвыборкой
+void Test15() {
+    using namespace std;
+
+    // После Compact узлы пула идут в памяти подряд в порядке обхода
+    {
+        SingleLinkedList<int, PoolAllocator<int>, ListStats> list;
+        mt19937 generator(15);
+        for (int i = 0; i < 1000; ++i) {
+            list.PushFront(static_cast<int>(generator() % 1000));
+        }
+        // Сортировка перецепляет узлы, и порядок обхода перестаёт совпадать с адресами
+        list.Sort();
+        const vector<int> values(list.begin(), list.end());
+
+        list.Compact();
+        assert(vector<int>(list.begin(), list.end()) == values);
+        assert(list.GetSize() == values.size());
+        assert(list.back() == values.back());
+        const auto* first = reinterpret_cast<const char*>(&*list.begin());
+        const auto* second = reinterpret_cast<const char*>(&*next(list.begin()));
+        const ptrdiff_t stride = second - first;
+        assert(stride > 0);
+        ptrdiff_t index = 0;
+        for (const int& value : list) {
+            assert(reinterpret_cast<const char*>(&value) - first == stride * index);
+            ++index;
+        }
+        const auto stats = list.GetStats().Snapshot();
+        assert(stats.operation_counts[static_cast<size_t>(ListOperation::COMPACT)] == 1u);
+        assert(stats.allocations - stats.frees == 1000u);
+
+        list.PushBack(-1);
+        assert(list.back() == -1);
+        assert(list.GetSize() == 1001u);
+    }
+
+    // Без выделения участков узлы просто создаются заново
+    {
+        SingleLinkedList<string> list{ "a"s, "b"s, "c"s };
+        list.Compact();
+        assert((list == SingleLinkedList<string>{ "a"s, "b"s, "c"s }));
+        assert(list.back() == "c");
+
+        SmallSingleLinkedList<string, 2> small{ "a"s, "b"s, "c"s, "d"s };
+        small.Compact();
+        assert((vector<string>(small.begin(), small.end()) == vector<string>{ "a", "b", "c", "d" }));
+        assert(small.back() == "d");
+    }
+
+    // Если копирование элемента выбросит исключение, список не изменится
+    {
+        struct ThrowOnCopy {
+            explicit ThrowOnCopy(int v, int* copies_left)
+                : value(v)
+                , copies_left_ptr(copies_left) {
+            }
+            ThrowOnCopy(const ThrowOnCopy& other)
+                : value(other.value)
+                , copies_left_ptr(other.copies_left_ptr) {
+                if (*copies_left_ptr == 0) {
+                    throw runtime_error("copy");
+                }
+                --*copies_left_ptr;
+            }
+            int value;
+            int* copies_left_ptr;
+        };
+
+        int copies_left = 2;
+        SingleLinkedList<ThrowOnCopy> list;
+        for (int i = 0; i < 5; ++i) {
+            list.EmplaceBack(i, &copies_left);
+        }
+        try {
+            list.Compact();
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        assert(list.GetSize() == 5u);
+        int expected = 0;
+        for (const auto& item : list) {
+            assert(item.value == expected++);
+        }
+    }
+
+    // Обход с предвыборкой проходит те же элементы
+    {
+        SingleLinkedList<int> list;
+        for (int i = 0; i < 100; ++i) {
+            list.PushFront(i);
+        }
+        for (size_t distance : { 0, 1, 4, 1000 }) {
+            int expected = 99;
+            for (int& value : list.Prefetched(distance)) {
+                assert(value == expected--);
+            }
+            assert(expected == -1);
+        }
+        for (int& value : list.Prefetched()) {
+            value *= 2;
+        }
+        const auto& const_list = list;
+        int sum = 0;
+        for (const int& value : const_list.Prefetched()) {
+            sum += value;
+        }
+        assert(sum == 99 * 100);
+
+        SingleLinkedList<int> empty;
+        assert(empty.Prefetched().begin() == empty.Prefetched().end());
+    }
+}
+
+// Эта функция тестирует параллельные алгоритмы над списком
+void Test16() {
+    using namespace std;
+    WorkStealingPool pool(3);
+    assert(pool.GetConcurrency() == 4u);
+
+    // Каждый элемент обрабатывается ровно один раз
+    {
+        SingleLinkedList<int> list;
+        for (int i = 0; i < 10000; ++i) {
+            list.PushFront(i);
+        }
+        list.ForEach(pool, [](int& value) {
+            value += 1;
+        });
+        list.TransformInPlace(pool, [](int value) {
+            return value * 2;
+        });
+        int expected = 10000;
+        for (int value : list) {
+            assert(value == 2 * expected--);
+        }
+        const long long sum = list.Reduce(pool, 0LL, [](long long acc, long long value) {
+            return acc + value;
+        });
+        assert(sum == 10000LL * 10001LL);
+
+        // Общий пул
+        list.ForEach([](int& value) {
+            value = 1;
+        });
+        assert(list.Reduce(size_t{ 0 }, plus<>{}) == 10000u);
+    }
+
+    // Результаты участков сворачиваются в порядке следования элементов
+    {
+        SingleLinkedList<string> list;
+        string expected;
+        for (int i = 0; i < 1000; ++i) {
+            list.PushBack(string(1, static_cast<char>('a' + i % 26)));
+            expected += static_cast<char>('a' + i % 26);
+        }
+        assert(list.Reduce(pool, ">"s, plus<>{}) == ">" + expected);
+    }
+
+    // Пустой и короткий списки
+    {
+        SingleLinkedList<int> empty;
+        empty.ForEach(pool, [](int&) {
+            assert(false);
+        });
+        assert(empty.Reduce(pool, 7, plus<>{}) == 7);
+
+        SingleLinkedList<int> one{ 5 };
+        assert(one.Reduce(pool, 7, plus<>{}) == 12);
+    }
+
+    // Исключение выбрасывается после обработки остальных участков
+    {
+        SingleLinkedList<int> list;
+        for (int i = 0; i < 5000; ++i) {
+            list.PushFront(i);
+        }
+        atomic<int> processed{ 0 };
+        try {
+            list.ForEach(pool, [&processed](int value) {
+                if (value == 1234) {
+                    throw runtime_error("element");
+                }
+                processed.fetch_add(1, memory_order_relaxed);
+            });
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        // Участок с исключением обрывается, остальные участки обрабатываются целиком
+        assert(processed.load() > 2500 && processed.load() < 5000);
+    }
+
+    // Вложенный параллельный обход из задачи пула не блокирует потоки
+    {
+        SingleLinkedList<SingleLinkedList<int>> lists;
+        for (int i = 0; i < 200; ++i) {
+            SingleLinkedList<int> inner;
+            for (int k = 0; k < 200; ++k) {
+                inner.PushFront(k);
+            }
+            lists.PushFront(std::move(inner));
+        }
+        lists.ForEach(pool, [&pool](SingleLinkedList<int>& inner) {
+            inner.TransformInPlace(pool, [](int value) {
+                return value + 1;
+            });
+        });
+        atomic<int> total{ 0 };
+        lists.ForEach(pool, [&pool, &total](const SingleLinkedList<int>& inner) {
+            total.fetch_add(inner.Reduce(pool, 0, plus<>{}), memory_order_relaxed);
+        });
+        assert(total.load() == 200 * (200 * 201 / 2));
+    }
+
+    // Пул без рабочих потоков выполняет всё в вызывающем потоке
+    {
+        WorkStealingPool serial(0);
+        SingleLinkedList<int> list{ 1, 2, 3 };
+        assert(list.Reduce(serial, 0, plus<>{}) == 6);
+    }
+}
+
+// Эта функция тестирует двоичную запись и чтение списков
+void Test17() {
+    using namespace std;
+
+    struct Record {
+        int64_t id;
+        double price;
+        char tag[4];
+    };
+
+    SingleLinkedList<Record> records;
+    for (int i = 0; i < 50000; ++i) {
+        records.PushBack({ i, i * 0.5, { 'a', 'b', 'c', static_cast<char>('0' + i % 10) } });
+    }
+    auto same_records = [](const SingleLinkedList<Record>& lhs, const SingleLinkedList<Record>& rhs) {
+        return lhs.GetSize() == rhs.GetSize()
+            && equal(lhs.begin(), lhs.end(), rhs.begin(), [](const Record& a, const Record& b) {
+                return a.id == b.id && a.price == b.price && memcmp(a.tag, b.tag, sizeof(a.tag)) == 0;
+            });
+    };
+
+    // Запись и чтение через потоки сохраняют порядок элементов
+    {
+        stringstream stream;
+        Serialize(stream, records);
+        assert(stream.str().size() == 16 + records.GetSize() * sizeof(Record));
+        SingleLinkedList<Record> loaded;
+        Deserialize(stream, loaded);
+        assert(same_records(records, loaded));
+        // Хвост построенного списка указывает на последний узел
+        loaded.PushBack({ -1, 0.0, {} });
+        assert(loaded.back().id == -1 && loaded.GetSize() == records.GetSize() + 1);
+    }
+
+    // Пустой список и чтение в непустой список
+    {
+        SingleLinkedList<int> empty;
+        stringstream stream;
+        Serialize(stream, empty);
+        SingleLinkedList<int> target{ 1, 2, 3 };
+        Deserialize(stream, target);
+        assert(target.IsEmpty());
+    }
+
+    // С аллокатором пула узлы каждой прочитанной порции выделяются одним участком, подряд и в порядке списка
+    {
+        stringstream stream;
+        Serialize(stream, records);
+        SingleLinkedList<Record, PoolAllocator<Record>> loaded;
+        Deserialize(stream, loaded);
+        assert(loaded.GetSize() == records.GetSize() && loaded.back().id == records.back().id);
+        const size_t portion = detail::SERIALIZE_BUFFER_SIZE / sizeof(Record);
+        const Record* previous = nullptr;
+        size_t index = 0;
+        for (const Record& record : loaded) {
+            if (index++ % portion != 0) {
+                assert(reinterpret_cast<const char*>(&record) > reinterpret_cast<const char*>(previous));
+            }
+            previous = &record;
+        }
+    }
+
+    // Файл читается через отображение в память
+    {
+        const string path = "single-linked-list-test17.bin";
+        SaveToFile(path, records);
+        SingleLinkedList<Record> loaded;
+        LoadFromFile(path, loaded);
+        assert(same_records(records, loaded));
+        remove(path.c_str());
+    }
+
+    // Повреждённые данные не меняют список
+    {
+        SingleLinkedList<int> source{ 1, 2, 3, 4 };
+        stringstream stream;
+        Serialize(stream, source);
+        const string bytes = stream.str();
+
+        auto expect_error = [](const string& data) {
+            SingleLinkedList<int> target{ 7, 8 };
+            istringstream input(data);
+            try {
+                Deserialize(input, target);
+                assert(false);
+            } catch (const ListFormatError&) {
+            }
+            assert((target == SingleLinkedList<int>{ 7, 8 }));
+        };
+        // Обрезанный заголовок и обрезанные данные
+        expect_error(bytes.substr(0, 10));
+        expect_error(bytes.substr(0, bytes.size() - 1));
+        // Другая сигнатура
+        string wrong_magic = bytes;
+        wrong_magic[0] ^= 0x7F;
+        expect_error(wrong_magic);
+        // Неизвестная версия
+        string wrong_version = bytes;
+        wrong_version[4] = 99;
+        expect_error(wrong_version);
+
+        // Элементы другого размера
+        stringstream other;
+        Serialize(other, SingleLinkedList<int64_t>{ 1, 2 });
+        expect_error(other.str());
+
+        // Огромное количество элементов в заголовке не приводит к выделению памяти под них
+        string huge_count = bytes;
+        const uint64_t count = UINT64_MAX / sizeof(int);
+        memcpy(huge_count.data() + 8, &count, sizeof(count));
+        expect_error(huge_count);
+
+        // Поток без позиционирования, например канал, читается порциями
+        struct PipeBuffer : streambuf {
+            explicit PipeBuffer(string data)
+                : data_(move(data)) {
+                setg(data_.data(), data_.data(), data_.data() + data_.size());
+            }
+
+            string data_;
+        };
+        auto read_pipe = [](const string& data, SingleLinkedList<int>& target) {
+            PipeBuffer buffer(data);
+            istream input(&buffer);
+            assert(input.tellg() == istream::pos_type(-1));
+            Deserialize(input, target);
+        };
+        SingleLinkedList<int> piped{ 7, 8 };
+        read_pipe(bytes, piped);
+        assert(piped == source);
+        for (const string& data : { huge_count, bytes.substr(0, bytes.size() - 1) }) {
+            try {
+                read_pipe(data, piped);
+                assert(false);
+            } catch (const ListFormatError&) {
+            }
+            assert(piped == source);
+        }
+
+        SingleLinkedList<int> large;
+        for (int i = 0; i < 100000; ++i) {
+            large.PushBack(i);
+        }
+        stringstream large_stream;
+        Serialize(large_stream, large);
+        read_pipe(large_stream.str(), piped);
+        assert(piped == large);
+        piped.PushBack(-1);
+        assert(piped.back() == -1 && piped.GetSize() == large.GetSize() + 1);
+    }
+}
+
+// Эта функция тестирует операторы сравнения списков
+void Test18() {
+    using namespace std;
+
+    // Результаты всех шести операторов совпадают с результатами для std::vector
+    auto check = [](const vector<int>& a, const vector<int>& b) {
+        const SingleLinkedList<int> la(a.begin(), a.end());
+        const SingleLinkedList<int> lb(b.begin(), b.end());
+        assert((la == lb) == (a == b));
+        assert((la != lb) == (a != b));
+        assert((la < lb) == (a < b));
+        assert((la <= lb) == (a <= b));
+        assert((la > lb) == (a > b));
+        assert((la >= lb) == (a >= b));
+
+        UnrolledLinkedList<int, 4> ua;
+        for (int value : a) {
+            ua.PushBack(value);
+        }
+        UnrolledLinkedList<int, 4> ub;
+        for (int value : b) {
+            ub.PushBack(value);
+        }
+        assert((ua == ub) == (a == b));
+        assert((ua != ub) == (a != b));
+        assert((ua < ub) == (a < b));
+        assert((ua <= ub) == (a <= b));
+        assert((ua > ub) == (a > b));
+        assert((ua >= ub) == (a >= b));
+    };
+
+    check({}, {});
+    check({}, { 1 });
+    check({ 1, 2, 3 }, { 1, 2, 3 });
+    check({ 1, 2, 3 }, { 1, 2 });
+    check({ 1, 2 }, { 1, 2, 3 });
+    check({ 1, 2, 3 }, { 1, 2, 4 });
+    check({ 3, 2, 1 }, { 1, 2, 3 });
+    // Отрицательные числа: побайтовое сравнение не годится для упорядочения
+    check({ 1, -1, 5 }, { 1, 1, 5 });
+    check({ 256 }, { 1 });
+
+    // Случайные пары длинных списков, различающихся в одном элементе или длиной
+    mt19937 generator(17);
+    for (int round = 0; round < 200; ++round) {
+        vector<int> a(generator() % 40);
+        for (int& value : a) {
+            value = static_cast<int>(generator() % 5) - 2;
+        }
+        vector<int> b = a;
+        switch (generator() % 3) {
+        case 0:
+            if (!b.empty()) {
+                b[generator() % b.size()] = static_cast<int>(generator() % 5) - 2;
+            }
+            break;
+        case 1:
+            b.push_back(0);
+            break;
+        default:
+            if (!b.empty()) {
+                b.pop_back();
+            }
+        }
+        check(a, b);
+        check(b, a);
+    }
+
+    // Длина сравнивается до обхода: списки разной длины с одинаковым началом не равны
+    {
+        SingleLinkedList<int> shorter{ 1, 2 };
+        SingleLinkedList<int> longer{ 1, 2, 3 };
+        assert(shorter != longer && longer != shorter);
+    }
+
+    // Элементы, для которых побайтовое сравнение не годится, сравниваются операторами Type
+    {
+        UnrolledLinkedList<double, 4> a;
+        UnrolledLinkedList<double, 4> b;
+        a.PushBack(0.0);
+        b.PushBack(-0.0);
+        assert(a == b && !(a < b) && a <= b && a >= b);
+        // NaN не равен сам себе, но и не меньше других чисел: порядок определяется только оператором <
+        const vector<vector<double>> samples{ { 1.0, NAN, 2.0 }, { 1.0, NAN, 3.0 }, { 1.0, 5.0, 2.0 }, { NAN }, { 0.5 } };
+        for (const auto& x : samples) {
+            for (const auto& y : samples) {
+                UnrolledLinkedList<double, 2> ux;
+                UnrolledLinkedList<double, 2> uy;
+                for (double value : x) {
+                    ux.PushBack(value);
+                }
+                for (double value : y) {
+                    uy.PushBack(value);
+                }
+                assert((ux < uy) == lexicographical_compare(x.begin(), x.end(), y.begin(), y.end()));
+            }
+        }
+        UnrolledLinkedList<string> s1{ "a", "b" };
+        UnrolledLinkedList<string> s2{ "a", "c" };
+        assert(s1 < s2 && s1 != s2);
+    }
+}
+
+// Эта функция тестирует список с индексом для доступа по номеру
+void Test19() {
+    using namespace std;
+
+    // Случайные вставки и удаления сверяются с вектором
+    {
+        IndexedSingleLinkedList<int> list;
+        vector<int> model;
+        mt19937 generator(19);
+        auto check_all = [&list, &model] {
+            assert(list.GetSize() == model.size());
+            assert(equal(list.begin(), list.end(), model.begin(), model.end()));
+            for (size_t i = 0; i < model.size(); ++i) {
+                assert(list.At(i) == model[i]);
+            }
+            assert(list.IteratorAt(model.size()) == list.end());
+        };
+        for (int step = 0; step < 20000; ++step) {
+            const unsigned action = generator() % 10;
+            const int value = static_cast<int>(generator() % 1000);
+            if (action < 2) {
+                list.PushFront(value);
+                model.insert(model.begin(), value);
+            } else if (action < 6 || model.empty()) {
+                const size_t index = generator() % (model.size() + 1);
+                // Вставка после элемента index - 1, при index == 0 - после before_begin
+                auto pos = index == 0 ? list.cbefore_begin() : list.IteratorAt(index - 1);
+                const auto inserted = list.InsertAfter(pos, value);
+                assert(*inserted == value);
+                model.insert(model.begin() + static_cast<ptrdiff_t>(index), value);
+            } else if (action < 9) {
+                const size_t index = generator() % model.size();
+                auto pos = index == 0 ? list.cbefore_begin() : list.IteratorAt(index - 1);
+                list.EraseAfter(pos);
+                model.erase(model.begin() + static_cast<ptrdiff_t>(index));
+            } else {
+                list.PopFront();
+                model.erase(model.begin());
+            }
+            if (step % 997 == 0) {
+                check_all();
+            }
+        }
+        check_all();
+        // Удаление всех элементов сворачивает индекс
+        while (!list.IsEmpty()) {
+            list.PopFront();
+        }
+        assert(list.IteratorAt(0) == list.end());
+        list.PushFront(5);
+        assert(list.At(0) == 5);
+    }
+
+    // Упорядоченная вставка и LowerBound
+    {
+        IndexedSingleLinkedList<int> sorted;
+        multiset<int> model;
+        mt19937 generator(23);
+        for (int i = 0; i < 5000; ++i) {
+            const int value = static_cast<int>(generator() % 2000);
+            sorted.InsertSorted(value);
+            model.insert(value);
+        }
+        assert(equal(sorted.begin(), sorted.end(), model.begin(), model.end()));
+        for (int value = -1; value <= 2001; value += 7) {
+            const auto expected = model.lower_bound(value);
+            const auto found = sorted.LowerBound(value);
+            if (expected == model.end()) {
+                assert(found == sorted.end());
+            } else {
+                assert(found != sorted.end() && *found == *expected);
+                // LowerBound находит первый из равных элементов
+                const auto before = sorted.LowerBoundBefore(value);
+                assert(before == sorted.cbefore_begin() || *before < value);
+            }
+        }
+        // Удаление в середине упорядоченного списка
+        for (int i = 0; i < 2500; ++i) {
+            const int value = static_cast<int>(generator() % 2000);
+            const auto before = sorted.LowerBoundBefore(value);
+            if (next(before) != sorted.end() && *next(before) == value) {
+                sorted.EraseAfter(before);
+                model.erase(model.find(value));
+            }
+        }
+        assert(equal(sorted.begin(), sorted.end(), model.begin(), model.end()));
+    }
+
+    // Построение над готовым списком, копирование, перемещение и выход за границы
+    {
+        SingleLinkedList<int> plain;
+        for (int i = 999; i >= 0; --i) {
+            plain.PushFront(i);
+        }
+        IndexedSingleLinkedList<int> indexed(std::move(plain));
+        assert(indexed.GetSize() == 1000 && indexed.At(500) == 500);
+
+        IndexedSingleLinkedList<int> copy = indexed;
+        copy.At(500) = -1;
+        assert(indexed.At(500) == 500 && copy.At(500) == -1);
+
+        IndexedSingleLinkedList<int> moved = std::move(copy);
+        assert(copy.IsEmpty() && moved.At(500) == -1 && moved.At(999) == 999);
+        moved.InsertAfter(moved.IteratorAt(500), 7);
+        assert(moved.At(501) == 7 && moved.At(1000) == 999);
+
+        try {
+            [[maybe_unused]] int value = moved.At(moved.GetSize());
+            assert(false);
+        } catch (const out_of_range&) {
+        }
+
+        SingleLinkedList<int> released = moved.Release();
+        assert(released.GetSize() == 1001 && moved.IsEmpty());
+    }
+}
+
+// Эта функция тестирует интрузивный список
+void Test20() {
+    using namespace std;
+
+    struct ByTime {};
+    struct Order : IntrusiveListHook<>, IntrusiveListHook<ByTime> {
+        explicit Order(int id)
+            : id(id) {
+        }
+
+        int id;
+    };
+
+    vector<unique_ptr<Order>> orders;
+    for (int i = 0; i < 6; ++i) {
+        orders.push_back(make_unique<Order>(i));
+    }
+    auto ids = [](const auto& list) {
+        vector<int> result;
+        for (const Order& order : list) {
+            result.push_back(order.id);
+        }
+        return result;
+    };
+
+    // Вставка и удаление не выделяют память и не копируют элементы
+    {
+        IntrusiveSingleLinkedList<Order> list;
+        assert(list.IsEmpty() && list.begin() == list.end());
+        list.PushFront(*orders[1]);
+        list.PushFront(*orders[0]);
+        list.PushBack(*orders[3]);
+        const auto inserted = list.InsertAfter(list.IteratorTo(*orders[1]), *orders[2]);
+        assert(&*inserted == orders[2].get());
+        assert((ids(list) == vector<int>{ 0, 1, 2, 3 }));
+        assert(list.GetSize() == 4 && &list.front() == orders[0].get() && &list.back() == orders[3].get());
+
+        // Удаление последнего элемента переносит хвост, и PushBack продолжает работать
+        list.EraseAfter(list.IteratorTo(*orders[2]));
+        assert(&list.back() == orders[2].get());
+        list.PushBack(*orders[4]);
+        assert((ids(list) == vector<int>{ 0, 1, 2, 4 }));
+
+        const auto next = list.EraseAfter(list.cbefore_begin());
+        assert(&*next == orders[1].get());
+        list.PopFront();
+        assert((ids(list) == vector<int>{ 2, 4 }));
+
+        // Изменение элемента через итератор видно владельцу объекта
+        list.begin()->id = 20;
+        assert(orders[2]->id == 20);
+        orders[2]->id = 2;
+
+        // Присваивание элементу списка меняет значение, но не связь
+        Order unlinked(7);
+        list.PushBack(*orders[3]);
+        *list.begin() = unlinked;
+        assert(orders[2]->id == 7 && (ids(list) == vector<int>{ 7, 4, 3 }) && list.GetSize() == 3);
+        const Order copy = *orders[4];
+        assert(copy.id == 4 && static_cast<const IntrusiveListHook<>&>(copy).next_node == nullptr);
+        orders[2]->id = 2;
+        list.EraseAfter(list.IteratorTo(*orders[4]));
+
+        // Перемещение и обмен сохраняют хвост
+        IntrusiveSingleLinkedList<Order> moved(std::move(list));
+        assert(list.IsEmpty() && moved.GetSize() == 2);
+        list.PushBack(*orders[5]);
+        swap(list, moved);
+        moved.PushBack(*orders[0]);
+        list.PushBack(*orders[1]);
+        assert((ids(list) == vector<int>{ 2, 4, 1 }));
+        assert((ids(moved) == vector<int>{ 5, 0 }));
+
+        list.Clear();
+        moved.Clear();
+        assert(list.IsEmpty() && moved.IsEmpty());
+    }
+
+    // Один объект в двух списках с разными звеньями
+    {
+        IntrusiveSingleLinkedList<Order> by_id;
+        IntrusiveSingleLinkedList<Order, ByTime> by_time;
+        for (auto& order : orders) {
+            by_id.PushBack(*order);
+            by_time.PushFront(*order);
+        }
+        assert((ids(by_id) == vector<int>{ 0, 1, 2, 3, 4, 5 }));
+        assert((ids(by_time) == vector<int>{ 5, 4, 3, 2, 1, 0 }));
+        by_time.EraseAfter(by_time.IteratorTo(*orders[4]));
+        assert((ids(by_id) == vector<int>{ 0, 1, 2, 3, 4, 5 }));
+        assert((ids(by_time) == vector<int>{ 5, 4, 2, 1, 0 }));
+        // Работа со стандартными алгоритмами через константные итераторы
+        const auto& const_by_id = by_id;
+        assert(find_if(const_by_id.begin(), const_by_id.end(), [](const Order& order) {
+            return order.id == 3;
+        }) == const_by_id.IteratorTo(*orders[3]));
+    }
+
+    // Интрузивный список не больше обычного списка
+    static_assert(sizeof(IntrusiveSingleLinkedList<Order>) == sizeof(SingleLinkedList<Order*>));
+}
+
+// Эта функция тестирует очередь с несколькими производителями и одним потребителем
+void Test21() {
+    using namespace std;
+
+    // Порядок элементов, ограничение ёмкости и перенос в список
+    {
+        MpscQueue<int> queue(4);
+        assert(queue.GetCapacity() == 4 && !queue.TryPop());
+        for (int i = 0; i < 4; ++i) {
+            assert(queue.TryPush(i));
+        }
+        assert(!queue.TryPush(4) && queue.GetSize() == 4);
+        assert(queue.TryPop() == 0 && queue.TryPop() == 1);
+        assert(queue.TryPush(4) && queue.TryPush(5));
+
+        SingleLinkedList<int> list{ -1 };
+        assert(queue.DrainInto(list) == 4);
+        assert((list == SingleLinkedList<int>{ -1, 2, 3, 4, 5 }));
+        assert(queue.GetSize() == 0 && !queue.TryPop() && queue.DrainInto(list) == 0);
+        // После переноса очередь продолжает работать со своего нового хвоста
+        assert(queue.TryPush(6));
+        list.PushBack(7);
+        assert(queue.DrainInto(list) == 1 && list.GetSize() == 7);
+        assert(queue.TryPush(8) && queue.TryPop() == 8 && queue.TryPush(9));
+        assert(queue.DrainInto(list) == 1);
+        assert((list == SingleLinkedList<int>{ -1, 2, 3, 4, 5, 7, 6, 9 }));
+    }
+
+    // Элементы с деструктором и перемещением: значения не теряются и не разрушаются дважды
+    {
+        MpscQueue<string> queue;
+        for (int i = 0; i < 100; ++i) {
+            queue.TryPush(string(40, 'a') + to_string(i));
+        }
+        for (int i = 0; i < 50; ++i) {
+            assert(*queue.TryPop() == string(40, 'a') + to_string(i));
+        }
+        SingleLinkedList<string> drained;
+        assert(queue.DrainInto(drained) == 50 && drained.back() == string(40, 'a') + "99");
+        // Освобождённые узлы переиспользуются, а оставшиеся элементы разрушаются вместе с очередью
+        for (int i = 0; i < 10; ++i) {
+            queue.TryPush(string(40, 'b'));
+        }
+    }
+
+    // Несколько производителей: каждый элемент получен ровно один раз, порядок элементов одного производителя сохраняется
+    {
+        constexpr int PRODUCERS = 3;
+        constexpr int PER_PRODUCER = 20000;
+        MpscQueue<int> queue(256);
+        vector<thread> producers;
+        for (int p = 0; p < PRODUCERS; ++p) {
+            producers.emplace_back([&queue, p] {
+                for (int i = 0; i < PER_PRODUCER; ++i) {
+                    while (!queue.TryPush(p * PER_PRODUCER + i)) {
+                        this_thread::yield();
+                    }
+                }
+            });
+        }
+        vector<int> last_seen(PRODUCERS, -1);
+        int received = 0;
+        auto accept = [&last_seen, &received](int value) {
+            const int producer = value / PER_PRODUCER;
+            assert(value % PER_PRODUCER == last_seen[producer] + 1);
+            last_seen[producer] = value % PER_PRODUCER;
+            ++received;
+        };
+        SingleLinkedList<int> batch;
+        while (received < PRODUCERS * PER_PRODUCER) {
+            if (received % 3 == 0) {
+                queue.DrainInto(batch);
+                for (int value : batch) {
+                    accept(value);
+                }
+                batch.Clear();
+            } else if (const auto value = queue.TryPop()) {
+                accept(*value);
+            } else {
+                this_thread::yield();
+            }
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        assert(!queue.TryPop() && queue.GetSize() == 0);
+    }
+
+    // Перенос всего списка при равных аллокаторах не обходит его узлы
+    {
+        SingleLinkedList<int> target{ 0 };
+        SingleLinkedList<int> source{ 1, 2, 3 };
+        target.SpliceAfter(target.cbegin(), source);
+        assert(source.IsEmpty() && (target == SingleLinkedList<int>{ 0, 1, 2, 3 }));
+        target.PushBack(4);
+        source.PushBack(5);
+        assert(target.back() == 4 && target.GetSize() == 5 && source.back() == 5);
+        target.SpliceAfter(target.cbefore_begin(), source);
+        assert((target == SingleLinkedList<int>{ 5, 0, 1, 2, 3, 4 }) && target.back() == 4);
+    }
+}
+
+// Эта функция тестирует персистентный список с общими хвостами
+void Test22() {
+    using namespace std;
+
+    // Копирование не выделяет память, изменения копии не видны оригиналу
+    {
+        size_t allocations = 0;
+        using List = PersistentSingleLinkedList<string, CountingAllocator<string>>;
+        const SingleLinkedList<string> source{ "a"s, "b"s, "c"s };
+        List original(source.begin(), source.end(), CountingAllocator<string>(allocations));
+        assert(allocations == 3 && original.GetSize() == 3 && original.front() == "a"s);
+
+        List copy = original;
+        assert(allocations == 3 && copy.SharesNodesWith(original) && copy == original);
+        copy.PushFront("z"s);
+        assert(allocations == 4 && !copy.SharesNodesWith(original));
+        assert(&*next(copy.begin()) == &original.front());
+        copy.PopFront();
+        copy.PopFront();
+        assert((copy == List({ "b"s, "c"s }, CountingAllocator<string>(allocations))));
+        assert(allocations == 6);
+        assert(original == List(source.begin(), source.end(), CountingAllocator<string>(allocations)));
+
+        List assigned{ CountingAllocator<string>(allocations) };
+        assigned = copy;
+        copy.Clear();
+        original = move(assigned);
+        assert(copy.IsEmpty() && assigned.IsEmpty() && original.GetSize() == 2 && original.front() == "b"s);
+        assert(original < List({ "c"s }, CountingAllocator<string>(allocations)) && original != copy && copy <= original);
+    }
+
+    // Копия освобождает общие узлы тем же пулом, которым они выделены, даже если оригинал разрушен первым
+    {
+        using List = PersistentSingleLinkedList<string, PoolAllocator<string>>;
+        auto original = make_unique<List>(List{ "a"s, "b"s, "c"s });
+        List copy = *original;
+        assert(copy.get_allocator() == original->get_allocator());
+        List moved = move(*original);
+        original->PushFront("d"s);
+        assert(original->get_allocator() == moved.get_allocator() && original->front() == "d"s);
+        original.reset();
+        moved.Clear();
+        assert(copy.GetSize() == 3 && copy.front() == "a"s);
+        copy.PopFront();
+        copy.PushFront("e"s);
+        assert((vector<string>(copy.begin(), copy.end()) == vector<string>{ "e"s, "b"s, "c"s }));
+    }
+
+    // Узел разрушается, когда на него не ссылается ни одна копия
+    {
+        struct Tracked {
+            explicit Tracked(int& counter)
+                : alive(&counter) {
+                ++*alive;
+            }
+
+            Tracked(const Tracked& other)
+                : alive(other.alive) {
+                ++*alive;
+            }
+
+            ~Tracked() {
+                --*alive;
+            }
+
+            int* alive;
+        };
+
+        int alive = 0;
+        {
+            PersistentSingleLinkedList<Tracked> list;
+            list.EmplaceFront(alive);
+            list.EmplaceFront(alive);
+            auto snapshot = list;
+            list.PopFront();
+            list.PopFront();
+            assert(alive == 2 && list.IsEmpty() && snapshot.GetSize() == 2);
+            snapshot.PopFront();
+            assert(alive == 1);
+            list = snapshot;
+            snapshot.Clear();
+            assert(alive == 1);
+        }
+        assert(alive == 0);
+    }
+
+    // Длинная цепочка освобождается без рекурсии
+    {
+        PersistentSingleLinkedList<int> list;
+        for (int i = 0; i < 1'000'000; ++i) {
+            list.PushFront(i);
+        }
+        auto snapshot = list;
+        list.Clear();
+        assert(snapshot.GetSize() == 1'000'000 && snapshot.front() == 999'999);
+    }
+
+    // Снимки читаются и изменяются в других потоках без блокировок
+    {
+        PersistentSingleLinkedList<int> list;
+        for (int i = 0; i < 1000; ++i) {
+            list.PushFront(i);
+        }
+        const int expected_sum = 999 * 1000 / 2;
+        vector<thread> readers;
+        for (int t = 0; t < 3; ++t) {
+            readers.emplace_back([snapshot = list]() mutable {
+                for (int round = 0; round < 200; ++round) {
+                    auto local = snapshot;
+                    local.PushFront(-1);
+                    local.PopFront();
+                    local.PopFront();
+                    int sum = 0;
+                    for (int value : snapshot) {
+                        sum += value;
+                    }
+                    assert(sum == expected_sum && local.GetSize() == 999);
+                }
+            });
+        }
+        for (int i = 0; i < 1000; ++i) {
+            list.PopFront();
+            list.PushFront(i);
+        }
+        list.Clear();
+        for (auto& reader : readers) {
+            reader.join();
+        }
+    }
+}
+
+// Эта функция тестирует список с хеш-индексом для поиска и удаления по значению
+void Test23() {
+    using namespace std;
+
+    // Случайные вставки и удаления с повторяющимися значениями сверяются с вектором
+    {
+        HashIndexedSingleLinkedList<int> list;
+        vector<int> model;
+        mt19937 generator(22);
+        auto iterator_at = [&list](size_t index) {
+            return index == 0 ? list.cbefore_begin() : next(list.cbegin(), static_cast<ptrdiff_t>(index - 1));
+        };
+        auto check_all = [&list, &model] {
+            assert(list.GetSize() == model.size());
+            assert(equal(list.begin(), list.end(), model.begin(), model.end()));
+            for (int value = 0; value < 60; ++value) {
+                const auto expected = static_cast<size_t>(count(model.begin(), model.end(), value));
+                assert(list.Count(value) == expected && list.Contains(value) == (expected != 0));
+                const auto found = list.Find(value);
+                assert(expected == 0 ? found == list.end() : *found == value);
+                assert(expected == 0 || next(list.FindBefore(value)) == found);
+            }
+        };
+        for (int step = 0; step < 20000; ++step) {
+            const unsigned action = generator() % 10;
+            const int value = static_cast<int>(generator() % 60);
+            if (action < 2) {
+                list.PushFront(value);
+                model.insert(model.begin(), value);
+            } else if (action < 5 || model.empty()) {
+                const size_t index = generator() % (model.size() + 1);
+                assert(*list.InsertAfter(iterator_at(index), value) == value);
+                model.insert(model.begin() + static_cast<ptrdiff_t>(index), value);
+            } else if (action < 7) {
+                const size_t index = generator() % model.size();
+                list.EraseAfter(iterator_at(index));
+                model.erase(model.begin() + static_cast<ptrdiff_t>(index));
+            } else if (action < 8) {
+                list.PopFront();
+                model.erase(model.begin());
+            } else if (action < 9) {
+                // Удаление первого найденного элемента через FindBefore
+                if (list.Contains(value)) {
+                    const auto pos = list.FindBefore(value);
+                    const auto index = static_cast<size_t>(distance(list.cbefore_begin(), pos));
+                    list.EraseAfter(pos);
+                    model.erase(model.begin() + static_cast<ptrdiff_t>(index));
+                }
+            } else {
+                const auto expected = static_cast<size_t>(count(model.begin(), model.end(), value));
+                assert(list.EraseValue(value) == expected);
+                model.erase(remove(model.begin(), model.end(), value), model.end());
+            }
+            if (step % 499 == 0) {
+                check_all();
+            }
+        }
+        check_all();
+        list.Clear();
+        assert(list.IsEmpty() && !list.Contains(0) && list.Find(0) == list.end());
+    }
+
+    // Удаление по ссылке на элемент самого списка, копирование, перемещение и обычный список
+    {
+        HashIndexedSingleLinkedList<string> sessions{ "a"s, "b"s, "a"s, "c"s, "a"s };
+        assert(sessions.EraseValue(*sessions.Find("a"s)) == 3);
+        assert((sessions.GetList() == SingleLinkedList<string>{ "b"s, "c"s }));
+
+        HashIndexedSingleLinkedList<string> copy = sessions;
+        copy.PushFront("d"s);
+        assert(copy.Contains("d"s) && !sessions.Contains("d"s) && copy.Find("b"s) != sessions.Find("b"s));
+        HashIndexedSingleLinkedList<string> moved = move(copy);
+        assert(moved.GetSize() == 3 && moved.EraseValue("c"s) == 1 && moved.EraseValue("c"s) == 0);
+
+        HashIndexedSingleLinkedList<string> adopted(moved.Release());
+        assert(moved.IsEmpty() && adopted.Contains("b"s) && *adopted.begin() == "d"s);
+        adopted.PopFront();
+        assert(!adopted.Contains("d"s) && next(adopted.FindBefore("b"s)) == adopted.begin());
+    }
+
+    // После копирования, перемещения и обмена первый элемент удаляется и вставляется через свой фиктивный узел
+    {
+        using Sessions = HashIndexedSingleLinkedList<string>;
+        auto check_front = [](Sessions& list) {
+            assert(list.FindBefore("x"s) == list.cbefore_begin() && list.Find("x"s) == list.begin());
+            list.PopFront();
+            assert(!list.Contains("x"s) && list.FindBefore("y"s) == list.cbefore_begin());
+            assert(list.EraseValue(*list.begin()) == 1 && *list.begin() == "z"s);
+            list.InsertAfter(list.cbefore_begin(), "w"s);
+            assert(list.FindBefore("w"s) == list.cbefore_begin() && next(list.FindBefore("z"s)) == list.Find("z"s));
+            assert((list.GetList() == SingleLinkedList<string>{ "w"s, "z"s }));
+        };
+
+        Sessions copy_assigned{ "q"s };
+        {
+            const Sessions source{ "x"s, "y"s, "z"s };
+            copy_assigned = source;
+        }
+        check_front(copy_assigned);
+
+        auto source = make_unique<Sessions>(Sessions{ "x"s, "y"s, "z"s });
+        Sessions move_constructed(move(*source));
+        source.reset();
+        check_front(move_constructed);
+
+        Sessions move_assigned{ "q"s };
+        source = make_unique<Sessions>(Sessions{ "x"s, "y"s, "z"s });
+        move_assigned = move(*source);
+        source.reset();
+        check_front(move_assigned);
+
+        Sessions swapped;
+        source = make_unique<Sessions>(Sessions{ "x"s, "y"s, "z"s });
+        swap(swapped, *source);
+        source.reset();
+        check_front(swapped);
+    }
+}
+
+// Эта функция тестирует список с 32-битными номерами узлов вместо указателей
+void Test24() {
+    using namespace std;
+
+    static_assert(CompactSingleLinkedList<uint32_t>::BYTES_PER_NODE == 8);
+    static_assert(CompactSingleLinkedList<uint64_t>::BYTES_PER_NODE == 12);
+
+    // Случайные вставки и удаления сверяются с вектором, освобождённые узлы переиспользуются
+    {
+        CompactSingleLinkedList<int> list;
+        vector<int> model;
+        mt19937 generator(24);
+        auto iterator_at = [&list](size_t index) {
+            return index == 0 ? list.cbefore_begin() : next(list.cbegin(), static_cast<ptrdiff_t>(index - 1));
+        };
+        for (int step = 0; step < 20000; ++step) {
+            const unsigned action = generator() % 10;
+            const int value = static_cast<int>(generator() % 1000);
+            if (action < 2) {
+                list.PushFront(value);
+                model.insert(model.begin(), value);
+            } else if (action < 3) {
+                list.PushBack(value);
+                model.push_back(value);
+            } else if (action < 6 || model.empty()) {
+                const size_t index = generator() % (model.size() + 1);
+                assert(*list.InsertAfter(iterator_at(index), value) == value);
+                model.insert(model.begin() + static_cast<ptrdiff_t>(index), value);
+            } else if (action < 9) {
+                const size_t index = generator() % model.size();
+                const auto next_it = list.EraseAfter(iterator_at(index));
+                model.erase(model.begin() + static_cast<ptrdiff_t>(index));
+                assert(index == model.size() ? next_it == list.end() : *next_it == model[index]);
+            } else {
+                list.PopFront();
+                model.erase(model.begin());
+            }
+            assert(list.GetSize() == model.size());
+            assert(model.empty() || (list.front() == model.front() && list.back() == model.back()));
+        }
+        assert(equal(list.begin(), list.end(), model.begin(), model.end()));
+        assert(list.GetCapacity() < 2 * model.size() + 4096);
+    }
+
+    // Итераторы не меняются при вставках, обмене и перемещении списков
+    {
+        CompactSingleLinkedList<string> list{ "b"s, "c"s };
+        auto it = list.begin();
+        for (int i = 0; i < 10000; ++i) {
+            list.PushFront(to_string(i));
+        }
+        assert(*it == "b"s && list.GetCapacity() >= 10002);
+        CompactSingleLinkedList<string> other{ "x"s };
+        list.swap(other);
+        assert(*it == "b"s && *++it == "c"s && ++it == other.end());
+        CompactSingleLinkedList<string> moved(move(other));
+        assert(other.IsEmpty() && other.begin() == other.end() && moved.GetSize() == 10002 && moved.back() == "c"s);
+        it = next(moved.begin(), 10000);
+        assert(*it == "b"s);
+
+        CompactSingleLinkedList<string> copy = moved;
+        assert(copy == moved && !(copy < moved) && copy.GetCapacity() <= moved.GetCapacity());
+        copy.EraseAfter(copy.cbefore_begin());
+        assert(copy != moved && copy < moved);
+        copy.Clear();
+        assert(copy.IsEmpty() && copy.GetCapacity() == 0 && copy.begin() == copy.end());
+        copy.EmplaceBack(3, 'z');
+        assert(copy.front() == "zzz"s && copy.back() == "zzz"s);
+    }
+
+    // Итераторы, полученные до первой вставки, в том числе у перемещённого списка, остаются действительными
+    {
+        CompactSingleLinkedList<int> list;
+        auto before = list.before_begin();
+        const auto end = list.cend();
+        list.PushFront(1);
+        assert(*++before == 1 && ++before == end && list.end() == end);
+
+        CompactSingleLinkedList<int> moved(move(list));
+        auto moved_from_before = list.cbefore_begin();
+        const auto moved_from_begin = list.cbegin();
+        list.PushFront(2);
+        assert(moved_from_begin == list.cend() && *++moved_from_before == 2 && moved.front() == 1);
+    }
+
+    // Исключение при создании элемента не меняет список, все созданные элементы разрушаются
+    {
+        struct Tracked {
+            Tracked(int& counter, bool fail)
+                : alive(&counter) {
+                if (fail) {
+                    throw runtime_error("Tracked");
+                }
+                ++*alive;
+            }
+
+            Tracked(const Tracked& other)
+                : alive(other.alive) {
+                ++*alive;
+            }
+
+            ~Tracked() {
+                --*alive;
+            }
+
+            int* alive;
+        };
+
+        int alive = 0;
+        {
+            CompactSingleLinkedList<Tracked> list;
+            list.EmplaceFront(alive, false);
+            list.EmplaceBack(alive, false);
+            try {
+                list.EmplaceAfter(list.cbegin(), alive, true);
+                assert(false);
+            } catch (const runtime_error&) {
+            }
+            assert(list.GetSize() == 2 && alive == 2);
+            CompactSingleLinkedList<Tracked> copy = list;
+            assert(alive == 4);
+            copy.PopFront();
+            assert(alive == 3);
+        }
+        assert(alive == 0);
+    }
+}
+
+#if SINGLE_LINKED_LIST_HAS_GENERATOR
+// Бесконечная последовательность квадратов натуральных чисел
+Generator<int> Squares() {
+    for (int i = 1;; ++i) {
+        co_yield i * i;
+    }
+}
+
+Generator<int> FailAfter(int count) {
+    for (int i = 0; i < count; ++i) {
+        co_yield i;
+    }
+    throw std::runtime_error("FailAfter");
+}
+#endif
+
+// Эта функция тестирует ленивые представления над списками
+void Test25() {
+    using namespace std;
+
+    SingleLinkedList<int> numbers;
+    for (int i = 10; i > 0; --i) {
+        numbers.PushFront(i);
+    }
+
+    // Несколько стадий без промежуточных списков, память выделяет только Collect
+    {
+        int transform_calls = 0;
+        const auto view = Lazy(numbers)
+                              .Filter([](int value) {
+                                  return value % 2 == 0;
+                              })
+                              .Transform([&transform_calls](int value) {
+                                  ++transform_calls;
+                                  return to_string(value * 10);
+                              })
+                              .Take(3);
+        assert(transform_calls == 0);
+        size_t allocations = 0;
+        const auto collected = view.Collect(CountingAllocator<string>(allocations));
+        assert((collected == SingleLinkedList<string, CountingAllocator<string>>({ "20"s, "40"s, "60"s },
+                                                                               CountingAllocator<string>(allocations))));
+        assert(transform_calls == 3 && allocations == 6);
+
+        // Представление можно обходить повторно, исходный список не меняется
+        vector<string> again(view.begin(), view.end());
+        assert((again == vector<string>{ "20"s, "40"s, "60"s }) && numbers.GetSize() == 10);
+        assert(Lazy(numbers).Take(0).Collect().IsEmpty() && Lazy(numbers).Take(100).Collect() == numbers);
+    }
+
+    // Группы и пары
+    {
+        vector<int> sums;
+        for (const auto& chunk : Lazy(numbers).Chunk(4)) {
+            int sum = 0;
+            for (int value : chunk) {
+                sum += value;
+            }
+            sums.push_back(sum);
+        }
+        assert((sums == vector<int>{ 10, 26, 19 }));
+        assert((*Lazy(numbers).Chunk(3).begin()).Collect() == (SingleLinkedList<int>{ 1, 2, 3 }));
+
+        const SingleLinkedList<string> names{ "a"s, "b"s, "c"s };
+        const auto zipped = Lazy(numbers).Zip(Lazy(names)).Collect();
+        assert(zipped.GetSize() == 3 && *zipped.begin() == make_pair(1, "a"s));
+        const auto labels = Lazy(names)
+                                .Zip(Lazy(numbers).Transform([](int value) {
+                                    return value * value;
+                                }))
+                                .Transform([](const auto& pair) {
+                                    return pair.first + to_string(pair.second);
+                                })
+                                .Collect();
+        assert((labels == SingleLinkedList<string>{ "a1"s, "b4"s, "c9"s }));
+
+        // Изменяемый список отдаёт элементы по ссылке
+        SingleLinkedList<int> mutable_list{ 1, 2, 3 };
+        for (int& value : Lazy(mutable_list).Filter([](int value) {
+                 return value != 2;
+             })) {
+            value = -value;
+        }
+        assert((mutable_list == SingleLinkedList<int>{ -1, 2, -3 }));
+    }
+
+    // С аллокатором пула Collect выделяет узлы одним участком, подряд и в порядке списка
+    {
+        const auto pooled = Lazy(numbers).Transform([](int value) {
+                                            return value + 1;
+                                        }).Collect(PoolAllocator<int>());
+        const int* previous = nullptr;
+        size_t adjacent = 0;
+        for (const int& value : pooled) {
+            if (previous != nullptr && &value > previous) {
+                ++adjacent;
+            }
+            previous = &value;
+        }
+        assert(pooled.GetSize() == 10 && adjacent == 9 && pooled.back() == 11);
+    }
+
+#if SINGLE_LINKED_LIST_HAS_GENERATOR
+    // Генератор выдаёт элементы по мере обхода, поэтому бесконечный источник ограничивается Take
+    {
+        auto squares = Squares();
+        const auto odd_squares = Lazy(squares)
+                                     .Filter([](int value) {
+                                         return value % 2 == 1;
+                                     })
+                                     .Take(4)
+                                     .Collect();
+        assert((odd_squares == SingleLinkedList<int>{ 1, 9, 25, 49 }));
+
+        auto failing = FailAfter(2);
+        SingleLinkedList<int> received;
+        try {
+            for (int value : failing) {
+                received.PushBack(value);
+            }
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        assert((received == SingleLinkedList<int>{ 0, 1 }));
+    }
+#endif
+}
+
 int main() {
     Test1();
     Test2();
+    Test3();
+    Test4();
+    Test5();
+    Test6();
+    Test7();
+    Test8();
+    Test9();
+    Test10();
+    Test11();
+    Test12();
+    Test13();
+    Test14();
+    Test15();
+    Test16();
+    Test17();
+    Test18();
+    Test19();
+    Test20();
+    Test21();
+    Test22();
+    Test23();
+    Test24();
+    Test25();
 }
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "single-linked-list.h"
+
+namespace detail {
+
+// Атомарные чтение и запись обычного поля-указателя. Связи узлов SingleLinkedList не атомарны,
+// а очередь связывает такие узлы из нескольких потоков, чтобы потом передать их списку без копирования
+template <typename T>
+[[nodiscard]] T* LoadAcquire(T* const& link) noexcept {
+#if defined(__cpp_lib_atomic_ref)
+    return std::atomic_ref<T*>(const_cast<T*&>(link)).load(std::memory_order_acquire);
+#elif defined(__GNUC__)
+    return __atomic_load_n(&link, __ATOMIC_ACQUIRE);
+#else
+#error "MpscQueue requires std::atomic_ref or GCC atomic builtins"
+#endif
+}
+
+template <typename T>
+void StoreRelease(T*& link, T* value) noexcept {
+#if defined(__cpp_lib_atomic_ref)
+    std::atomic_ref<T*>(link).store(value, std::memory_order_release);
+#elif defined(__GNUC__)
+    __atomic_store_n(&link, value, __ATOMIC_RELEASE);
+#endif
+}
+
+}  // namespace detail
+
+/*
+ * Очередь с несколькими производителями и одним потребителем (годится и для одного производителя).
+ * Элементы хранятся в узлах SingleLinkedList<Type, Allocator>, связанных в порядке поступления.
+ * Производитель добавляет узел в хвост одной атомарной заменой хвоста и одной записью ссылки,
+ * без циклов повтора и блокировок. Узел берётся из списка свободных одной попыткой, а при неудаче
+ * выделяется аллокатором, поэтому вставка не ждёт других потоков, если не ждёт сам аллокатор. Потребитель забирает элементы из начала по одному (TryPop)
+ * или все сразу (DrainInto), и тогда цепочка узлов присоединяется к списку без копирования.
+ * Узлы извлечённых по одному элементов возвращаются в список свободных узлов и переиспользуются.
+ * Аллокатор должен допускать одновременные вызовы из разных потоков, как std::allocator
+ */
+template <typename Type, typename Allocator = std::allocator<Type>>
+class MpscQueue {
+    using List = SingleLinkedList<Type, Allocator>;
+    using NodeBase = typename List::NodeBase;
+    using Node = typename List::Node;
+    using NodeAllocator = typename List::NodeAllocator;
+    using NodeTraits = typename List::NodeTraits;
+
+public:
+    // capacity - наибольшее число элементов в очереди, 0 - без ограничения
+    explicit MpscQueue(size_t capacity = 0, const Allocator& alloc = Allocator())
+        : alloc_(alloc)
+        , capacity_(capacity)
+        , max_free_nodes_(capacity != 0 ? capacity : DEFAULT_MAX_FREE_NODES) {
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // К моменту разрушения производители должны завершить работу с очередью
+    ~MpscQueue() {
+        NodeBase* node = head_->next_node;
+        RetireHead();
+        while (node != nullptr) {
+            NodeBase* next = node->next_node;
+            NodeTraits::destroy(alloc_, static_cast<Node*>(node));
+            NodeTraits::deallocate(alloc_, static_cast<Node*>(node), 1);
+            node = next;
+        }
+        void* free_node = free_nodes_.load(std::memory_order_relaxed);
+        while (free_node != nullptr) {
+            void* next = NextFree(free_node);
+            NodeTraits::deallocate(alloc_, static_cast<Node*>(free_node), 1);
+            free_node = next;
+        }
+    }
+
+    // Примерное число элементов: производители учитывают элемент до того, как он станет виден потребителю
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    // Вызывается из любого потока. Возвращает false, если очередь заполнена
+    bool TryPush(const Type& value) {
+        return TryEmplace(value);
+    }
+
+    bool TryPush(Type&& value) {
+        return TryEmplace(std::move(value));
+    }
+
+    /*
+     * Конструирует элемент из args в хвосте очереди. Вызывается из любого потока.
+     * Возвращает false, если очередь заполнена.
+     * Если конструктор Type или аллокатор выбросит исключение, очередь не изменится
+     */
+    template <typename... Args>
+    bool TryEmplace(Args&&... args) {
+        // Место резервируется до создания узла, поэтому очередь не превышает capacity_ даже на мгновение
+        const size_t reserved = size_.fetch_add(1, std::memory_order_relaxed);
+        if (capacity_ != 0 && reserved >= capacity_) {
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+        Node* node = nullptr;
+        try {
+            node = AcquireNode();
+            NodeTraits::construct(alloc_, node, std::in_place, nullptr, std::forward<Args>(args)...);
+        } catch (...) {
+            if (node != nullptr) {
+                NodeTraits::deallocate(alloc_, node, 1);
+            }
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+        // Хвост меняется одной операцией: каждый производитель получает своего предшественника
+        NodeBase* prev = tail_.exchange(node, std::memory_order_acq_rel);
+        detail::StoreRelease(prev->next_node, static_cast<NodeBase*>(node));
+        return true;
+    }
+
+    /*
+     * Извлекает первый элемент. Вызывается только потребителем.
+     * Возвращает std::nullopt, если очередь пуста или первый производитель ещё не завершил вставку
+     */
+    [[nodiscard]] std::optional<Type> TryPop() {
+        NodeBase* next = detail::LoadAcquire(head_->next_node);
+        if (next == nullptr) {
+            return std::nullopt;
+        }
+        std::optional<Type> result(std::move(List::ValueOf(next)));
+        // Узел с перемещённым значением становится фиктивным началом очереди,
+        // а прежнее фиктивное начало уходит в список свободных узлов
+        RetireHead();
+        head_ = next;
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return result;
+    }
+
+    /*
+     * Переносит все элементы очереди в конец list. Вызывается только потребителем.
+     * Хвост очереди отцепляется одной атомарной операцией, и цепочка присоединяется к list без копирования.
+     * Перед этим цепочка проходится, чтобы дождаться производителей, которые уже заменили хвост,
+     * но ещё не записали ссылку на свой узел, и сосчитать узлы. Возвращает число перенесённых элементов.
+     * Если аллокатор list не равен аллокатору очереди, элементы перемещаются в узлы list
+     */
+    size_t DrainInto(List& list) {
+        NodeBase* first = detail::LoadAcquire(head_->next_node);
+        if (first == nullptr) {
+            return 0;
+        }
+        // Новым хвостом становится фиктивный узел, который сейчас не стоит в начале очереди
+        NodeBase* stub = head_ == &stubs_[0] ? &stubs_[1] : &stubs_[0];
+        stub->next_node = nullptr;
+        NodeBase* last = tail_.exchange(stub, std::memory_order_acq_rel);
+        size_t count = 1;
+        for (NodeBase* node = first; node != last; ++count) {
+            NodeBase* next = detail::LoadAcquire(node->next_node);
+            while (next == nullptr) {
+                std::this_thread::yield();
+                next = detail::LoadAcquire(node->next_node);
+            }
+            node = next;
+        }
+        RetireHead();
+        head_ = stub;
+        size_.fetch_sub(count, std::memory_order_relaxed);
+
+        List chain(alloc_);
+        chain.head_.next_node = first;
+        chain.tail_ = last;
+        chain.size_ = count;
+        list.SpliceBack(chain);
+        return count;
+    }
+
+private:
+    // Сколько освобождённых узлов очередь без ограничения держит для повторного использования
+    static constexpr size_t DEFAULT_MAX_FREE_NODES = 1024;
+
+    [[nodiscard]] bool IsStub(const NodeBase* node) const noexcept {
+        return node == &stubs_[0] || node == &stubs_[1];
+    }
+
+    // Ссылка на следующий свободный узел хранится в первых байтах памяти узла, где объекта уже нет
+    [[nodiscard]] static void* NextFree(void* node) noexcept {
+        void* next;
+        std::memcpy(&next, node, sizeof(next));
+        return next;
+    }
+
+    // Разрушает фиктивное начало очереди, если это узел, а не один из stubs_, и освобождает его память
+    void RetireHead() noexcept {
+        if (IsStub(head_)) {
+            return;
+        }
+        Node* node = static_cast<Node*>(head_);
+        NodeTraits::destroy(alloc_, node);
+        if (free_count_.load(std::memory_order_relaxed) >= max_free_nodes_) {
+            NodeTraits::deallocate(alloc_, node, 1);
+            return;
+        }
+        void* top = free_nodes_.load(std::memory_order_relaxed);
+        do {
+            std::memcpy(static_cast<void*>(node), &top, sizeof(top));
+        } while (!free_nodes_.compare_exchange_weak(top, node, std::memory_order_release, std::memory_order_relaxed));
+        free_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Берёт узел из списка свободных либо выделяет новый.
+    // Свободные узлы забирают по одному производителю за раз: тогда между чтением вершины и её заменой
+    // узел не может уйти и вернуться (проблема ABA). Занятый мьютекс не ждут, а выделяют память.
+    // Вершину пытаются снять один раз: если потребитель успел положить узел, выделяется новый,
+    // поэтому число шагов производителя ограничено
+    Node* AcquireNode() {
+        if (free_nodes_.load(std::memory_order_relaxed) != nullptr && free_mutex_.try_lock()) {
+            std::lock_guard guard(free_mutex_, std::adopt_lock);
+            void* top = free_nodes_.load(std::memory_order_acquire);
+            if (top != nullptr
+                && free_nodes_.compare_exchange_strong(top, NextFree(top), std::memory_order_acquire, std::memory_order_relaxed)) {
+                free_count_.fetch_sub(1, std::memory_order_relaxed);
+                return static_cast<Node*>(top);
+            }
+        }
+        return NodeTraits::allocate(alloc_, 1);
+    }
+
+    NodeAllocator alloc_;
+    const size_t capacity_;
+    const size_t max_free_nodes_;
+    // Фиктивные узлы начала. DrainInto делает хвостом тот из них, который не стоит в начале очереди
+    NodeBase stubs_[2];
+
+    // Начало очереди меняет только потребитель, хвост - производители
+    alignas(detail::CACHE_LINE_SIZE) NodeBase* head_ = &stubs_[0];
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<NodeBase*> tail_{ &stubs_[0] };
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<size_t> size_{ 0 };
+    alignas(detail::CACHE_LINE_SIZE) std::atomic<void*> free_nodes_{ nullptr };
+    std::atomic<size_t> free_count_{ 0 };
+    std::mutex free_mutex_;
+};
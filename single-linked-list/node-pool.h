@@ -0,0 +1,259 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+
+// Пул узлов фиксированного размера.
+// Память выделяется блоками, внутри блока слоты раздаются подряд,
+// освобождённые слоты попадают в список свободных и переиспользуются.
+// Пул не потокобезопасен: один пул должен обслуживать списки одного потока
+class NodePool {
+public:
+    NodePool() = default;
+
+    explicit NodePool(size_t max_block_slots) noexcept
+        : max_block_slots_(std::max<size_t>(max_block_slots, MIN_BLOCK_SLOTS)) {
+    }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    ~NodePool() {
+        ReleaseAll();
+    }
+
+    // Наибольшее число слотов в одном блоке
+    [[nodiscard]] size_t GetMaxBlockSlots() const noexcept {
+        return max_block_slots_;
+    }
+
+    // Выделяет память под один объект размера size с выравниванием align.
+    // Размер слота фиксируется при первом вызове. Запросы, которые в слот не помещаются,
+    // обслуживаются глобальным operator new
+    [[nodiscard]] void* Allocate(size_t size, size_t align) {
+        if (slot_size_ == 0) {
+            Configure(size, align);
+        }
+        if (!FitsSlot(size, align)) {
+            return ::operator new(size, std::align_val_t{ align });
+        }
+        if (free_list_ != nullptr) {
+            FreeSlot* slot = free_list_;
+            // Слот мог попасть в список через DeallocateChain, где ссылку записал владелец объекта
+            std::memcpy(&free_list_, slot, sizeof(free_list_));
+            return slot;
+        }
+        if (bump_ == bump_end_) {
+            AllocateBlock(next_block_slots_);
+        }
+        void* slot = bump_;
+        bump_ += slot_size_;
+        return slot;
+    }
+
+    // Выделяет count подряд идущих слотов под объекты размера size.
+    // Каждый слот потом освобождается отдельно через Deallocate.
+    // Возвращает nullptr, если объекты такого размера пул не обслуживает
+    [[nodiscard]] void* AllocateRun(size_t count, size_t size, size_t align) {
+        if (slot_size_ == 0) {
+            Configure(size, align);
+        }
+        if (size != slot_size_ || align > slot_align_) {
+            return nullptr;
+        }
+        if (static_cast<size_t>(bump_end_ - bump_) < count * slot_size_) {
+            RetireBumpRegion();
+            AllocateBlock(std::max(count, next_block_slots_));
+        }
+        void* run = bump_;
+        bump_ += count * slot_size_;
+        return run;
+    }
+
+    // Возвращает слот в список свободных за время O(1)
+    void Deallocate(void* ptr, size_t size, size_t align) noexcept {
+        if (!FitsSlot(size, align)) {
+            ::operator delete(ptr, std::align_val_t{ align });
+            return;
+        }
+        FreeSlot* slot = static_cast<FreeSlot*>(ptr);
+        slot->next = free_list_;
+        free_list_ = slot;
+    }
+
+    /*
+     * Возвращает в список свободных цепочку объектов от first до last за время O(1).
+     * В начале каждого объекта цепочки должен лежать указатель на следующий объект,
+     * объекты должны быть уже разрушены. Возвращает false, если объекты такого размера
+     * пул не обслуживает, тогда их нужно освободить по одному
+     */
+    [[nodiscard]] bool DeallocateChain(void* first, void* last, size_t size, size_t align) noexcept {
+        if (slot_size_ == 0 || !FitsSlot(size, align)) {
+            return false;
+        }
+        FreeSlot* tail = static_cast<FreeSlot*>(last);
+        tail->next = free_list_;
+        free_list_ = static_cast<FreeSlot*>(first);
+        return true;
+    }
+
+    // Освобождает все блоки пула целиком за время O(количество блоков).
+    // Вызывать можно, только если в пуле не осталось живых объектов
+    void ReleaseAll() noexcept {
+        while (blocks_ != nullptr) {
+            Block* next = blocks_->next;
+            ::operator delete(blocks_, std::align_val_t{ block_align_ });
+            blocks_ = next;
+        }
+        free_list_ = nullptr;
+        bump_ = bump_end_ = nullptr;
+        next_block_slots_ = MIN_BLOCK_SLOTS;
+    }
+
+private:
+    static constexpr size_t MIN_BLOCK_SLOTS = 16;
+    static constexpr size_t DEFAULT_MAX_BLOCK_SLOTS = 4096;
+
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    // Заголовок блока, за ним следуют слоты
+    struct Block {
+        Block* next;
+    };
+
+    void Configure(size_t size, size_t align) noexcept {
+        slot_align_ = std::max(align, alignof(FreeSlot));
+        slot_size_ = RoundUp(std::max(size, sizeof(FreeSlot)), slot_align_);
+        block_align_ = std::max(slot_align_, alignof(Block));
+        header_size_ = RoundUp(sizeof(Block), slot_align_);
+    }
+
+    [[nodiscard]] bool FitsSlot(size_t size, size_t align) const noexcept {
+        return size <= slot_size_ && align <= slot_align_;
+    }
+
+    // Блоки растут геометрически, чтобы маленькие списки не занимали лишнюю память
+    void AllocateBlock(size_t slots) {
+        void* raw = ::operator new(header_size_ + slots * slot_size_, std::align_val_t{ block_align_ });
+        Block* block = static_cast<Block*>(raw);
+        block->next = blocks_;
+        blocks_ = block;
+        bump_ = static_cast<char*>(raw) + header_size_;
+        bump_end_ = bump_ + slots * slot_size_;
+        next_block_slots_ = std::min(std::max(slots, next_block_slots_) * 2, max_block_slots_);
+    }
+
+    // Переносит нераспределённый остаток текущего блока в список свободных слотов
+    void RetireBumpRegion() noexcept {
+        for (; bump_ != bump_end_; bump_ += slot_size_) {
+            FreeSlot* slot = reinterpret_cast<FreeSlot*>(bump_);
+            slot->next = free_list_;
+            free_list_ = slot;
+        }
+    }
+
+    static constexpr size_t RoundUp(size_t value, size_t align) noexcept {
+        return (value + align - 1) / align * align;
+    }
+
+    size_t max_block_slots_ = DEFAULT_MAX_BLOCK_SLOTS;
+    size_t next_block_slots_ = MIN_BLOCK_SLOTS;
+    size_t slot_size_ = 0;
+    size_t slot_align_ = 0;
+    size_t block_align_ = alignof(Block);
+    size_t header_size_ = sizeof(Block);
+    FreeSlot* free_list_ = nullptr;
+    char* bump_ = nullptr;
+    char* bump_end_ = nullptr;
+    Block* blocks_ = nullptr;
+};
+
+// Аллокатор, раздающий одиночные объекты из NodePool.
+// Копии аллокатора (в том числе rebind-копии) разделяют один пул.
+// При копировании контейнера создаётся новый пул с теми же настройками, чтобы копии списков не делили состояние
+template <typename T>
+class PoolAllocator {
+    template <typename U>
+    friend class PoolAllocator;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    PoolAllocator()
+        : pool_(std::make_shared<NodePool>()) {
+    }
+
+    explicit PoolAllocator(size_t max_block_slots)
+        : pool_(std::make_shared<NodePool>(max_block_slots)) {
+    }
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept
+        : pool_(other.pool_) {
+    }
+
+    [[nodiscard]] T* allocate(size_t n) {
+        if (n != 1) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ alignof(T) }));
+        }
+        return static_cast<T*>(pool_->Allocate(sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        if (n != 1) {
+            ::operator delete(ptr, std::align_val_t{ alignof(T) });
+            return;
+        }
+        pool_->Deallocate(ptr, sizeof(T), alignof(T));
+    }
+
+    // Возвращает пулу цепочку объектов, выделенных по одному, см. NodePool::DeallocateChain
+    [[nodiscard]] bool DeallocateChain(T* first, T* last) noexcept {
+        return pool_->DeallocateChain(first, last, sizeof(T), alignof(T));
+    }
+
+    // Выделяет count подряд идущих объектов, каждый из которых освобождается
+    // отдельно через deallocate(ptr, 1). Возвращает nullptr, если пул не может выдать такой участок
+    [[nodiscard]] T* AllocateBatch(size_t count) {
+        return static_cast<T*>(pool_->AllocateRun(count, sizeof(T), alignof(T)));
+    }
+
+    // Новый пул настраивается так же, как пул исходного аллокатора
+    [[nodiscard]] PoolAllocator select_on_container_copy_construction() const {
+        return PoolAllocator(pool_->GetMaxBlockSlots());
+    }
+
+    [[nodiscard]] size_t GetMaxBlockSlots() const noexcept {
+        return pool_->GetMaxBlockSlots();
+    }
+
+    // Пул принадлежит только этому аллокатору, и его можно освободить целиком
+    [[nodiscard]] bool IsExclusive() const noexcept {
+        return pool_.use_count() == 1;
+    }
+
+    void ReleaseAll() noexcept {
+        pool_->ReleaseAll();
+    }
+
+    template <typename U>
+    [[nodiscard]] bool operator==(const PoolAllocator<U>& rhs) const noexcept {
+        return pool_ == rhs.pool_;
+    }
+
+    template <typename U>
+    [[nodiscard]] bool operator!=(const PoolAllocator<U>& rhs) const noexcept {
+        return pool_ != rhs.pool_;
+    }
+
+private:
+    std::shared_ptr<NodePool> pool_;
+};
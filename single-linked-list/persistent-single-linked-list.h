@@ -0,0 +1,340 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include "single-linked-list.h"
+
+/*
+ * Персистентный односвязный список с разделяемыми хвостами.
+ * Узлы неизменяемы и считают ссылки на себя: копия списка указывает на тот же первый узел,
+ * поэтому копирование занимает O(1) и ничего не выделяет. PushFront создаёт один узел перед
+ * общей цепочкой, PopFront лишь переставляет начало, остальные копии при этом не меняются.
+ * Элементы доступны только для чтения.
+ * Разные копии можно читать, изменять и разрушать из разных потоков без блокировок,
+ * как разные экземпляры std::shared_ptr. Один объект списка из нескольких потоков
+ * одновременно изменять нельзя. Последнюю ссылку на узел может снять любой поток,
+ * поэтому аллокатор должен допускать вызовы из разных потоков, а его копии - быть равны
+ */
+template <typename Type, typename Allocator = std::allocator<Type>>
+class PersistentSingleLinkedList {
+    // Узел списка. После создания узел не меняется, кроме счётчика ссылок
+    struct Node {
+        template <typename... Args>
+        Node(std::in_place_t, Node* next, Args&&... args)
+            : next_node(next)
+            , value(std::forward<Args>(args)...) {
+        }
+
+        // Число списков и узлов, указывающих на этот узел
+        std::atomic<size_t> ref_count{ 1 };
+        Node* next_node;
+        const Type value;
+    };
+
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    // Указатель на первый узел. Аллокатор хранится как база, чтобы аллокатор без состояния не занимал места
+    struct Head : NodeAllocator {
+        Head() = default;
+
+        explicit Head(const NodeAllocator& alloc) noexcept
+            : NodeAllocator(alloc) {
+        }
+
+        Node* node = nullptr;
+    };
+
+    class ConstIteratorImpl {
+        friend class PersistentSingleLinkedList;
+
+        explicit ConstIteratorImpl(const Node* node) noexcept
+            : node_(node) {
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Type*;
+        using reference = const Type&;
+
+        ConstIteratorImpl() = default;
+
+        [[nodiscard]] bool operator==(const ConstIteratorImpl& rhs) const noexcept {
+            return node_ == rhs.node_;
+        }
+
+        [[nodiscard]] bool operator!=(const ConstIteratorImpl& rhs) const noexcept {
+            return node_ != rhs.node_;
+        }
+
+        ConstIteratorImpl& operator++() noexcept {
+            assert(node_ != nullptr);
+            node_ = node_->next_node;
+            return *this;
+        }
+
+        ConstIteratorImpl operator++(int) noexcept {
+            auto old_value(*this);
+            ++*this;
+            return old_value;
+        }
+
+        [[nodiscard]] reference operator*() const noexcept {
+            assert(node_ != nullptr);
+            return node_->value;
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept {
+            assert(node_ != nullptr);
+            return &node_->value;
+        }
+
+    private:
+        const Node* node_ = nullptr;
+    };
+
+public:
+    using value_type = Type;
+    using reference = const value_type&;
+    using const_reference = const value_type&;
+    using allocator_type = Allocator;
+
+    // Элементы неизменяемы, поэтому оба итератора дают доступ только для чтения
+    using Iterator = ConstIteratorImpl;
+    using ConstIterator = ConstIteratorImpl;
+
+    PersistentSingleLinkedList() = default;
+
+    explicit PersistentSingleLinkedList(const Allocator& alloc) noexcept
+        : head_(NodeAllocator(alloc)) {
+    }
+
+    PersistentSingleLinkedList(std::initializer_list<Type> i_list, const Allocator& alloc = Allocator())
+        : PersistentSingleLinkedList(i_list.begin(), i_list.end(), alloc) {
+    }
+
+    // Строит список из элементов [first, last) в том же порядке, например снимок SingleLinkedList
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    PersistentSingleLinkedList(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+        : head_(NodeAllocator(alloc)) {
+        // Пока узлы не видны другим спискам, их можно связывать по порядку от начала к концу
+        Node** link = &head_.node;
+        try {
+            for (; first != last; ++first) {
+                *link = CreateNode(nullptr, *first);
+                link = &(*link)->next_node;
+                ++size_;
+            }
+        } catch (...) {
+            Release(head_.node);
+            throw;
+        }
+    }
+
+    // Копия разделяет все узлы с other и создаётся за время O(1).
+    // Общие узлы может освободить любая из копий, поэтому копия берёт аллокатор other,
+    // а не select_on_container_copy_construction
+    PersistentSingleLinkedList(const PersistentSingleLinkedList& other) noexcept
+        : head_(other.Alloc())
+        , size_(other.size_) {
+        head_.node = Retain(other.head_.node);
+    }
+
+    // Аллокатор копируется: other остаётся пригодным к использованию и выделяет узлы тем же аллокатором
+    PersistentSingleLinkedList(PersistentSingleLinkedList&& other) noexcept
+        : head_(other.Alloc())
+        , size_(std::exchange(other.size_, 0)) {
+        head_.node = std::exchange(other.head_.node, nullptr);
+    }
+
+    PersistentSingleLinkedList& operator=(const PersistentSingleLinkedList& rhs) noexcept {
+        if (this != &rhs) {
+            PersistentSingleLinkedList copy(rhs);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    PersistentSingleLinkedList& operator=(PersistentSingleLinkedList&& rhs) noexcept {
+        if (this != &rhs) {
+            PersistentSingleLinkedList moved(std::move(rhs));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    ~PersistentSingleLinkedList() {
+        Release(head_.node);
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept {
+        return allocator_type(Alloc());
+    }
+
+    [[nodiscard]] const Type& front() const noexcept {
+        assert(!IsEmpty());
+        return head_.node->value;
+    }
+
+    // Вставляет элемент в начало за время O(1). Остальные узлы остаются общими с копиями списка
+    void PushFront(const Type& value) {
+        EmplaceFront(value);
+    }
+
+    void PushFront(Type&& value) {
+        EmplaceFront(std::move(value));
+    }
+
+    template <typename... Args>
+    const Type& EmplaceFront(Args&&... args) {
+        // Новый узел забирает ссылку списка на прежний первый узел
+        head_.node = CreateNode(head_.node, std::forward<Args>(args)...);
+        ++size_;
+        return head_.node->value;
+    }
+
+    // Убирает первый элемент за время O(1). Узел разрушается, только если на него не ссылаются копии
+    void PopFront() noexcept {
+        assert(!IsEmpty());
+        Node* old_head = head_.node;
+        head_.node = Retain(old_head->next_node);
+        --size_;
+        Release(old_head);
+    }
+
+    // Отпускает все узлы. Разрушаются только те, на которые не ссылаются копии списка
+    void Clear() noexcept {
+        Release(std::exchange(head_.node, nullptr));
+        size_ = 0;
+    }
+
+    // Возвращает true, если списки начинаются с одного и того же узла, то есть целиком состоят из общих узлов
+    [[nodiscard]] bool SharesNodesWith(const PersistentSingleLinkedList& other) const noexcept {
+        return head_.node != nullptr && head_.node == other.head_.node;
+    }
+
+    void swap(PersistentSingleLinkedList& other) noexcept {
+        using std::swap;
+        swap(Alloc(), other.Alloc());
+        swap(head_.node, other.head_.node);
+        swap(size_, other.size_);
+    }
+
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        return ConstIterator{ head_.node };
+    }
+
+    [[nodiscard]] ConstIterator end() const noexcept {
+        return {};
+    }
+
+    [[nodiscard]] ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    [[nodiscard]] ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    [[nodiscard]] NodeAllocator& Alloc() noexcept {
+        return head_;
+    }
+
+    [[nodiscard]] const NodeAllocator& Alloc() const noexcept {
+        return head_;
+    }
+
+    template <typename... Args>
+    [[nodiscard]] Node* CreateNode(Node* next, Args&&... args) {
+        Node* node = NodeTraits::allocate(Alloc(), 1);
+        try {
+            NodeTraits::construct(Alloc(), node, std::in_place, next, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(Alloc(), node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    // Добавляет ссылку на node. Новая ссылка появляется от уже существующей, поэтому порядок не нужен
+    static Node* Retain(Node* node) noexcept {
+        if (node != nullptr) {
+            node->ref_count.fetch_add(1, std::memory_order_relaxed);
+        }
+        return node;
+    }
+
+    // Снимает ссылку с node и разрушает узлы, на которые больше никто не ссылается.
+    // Цепочка освобождается циклом, а не рекурсией, чтобы длинный список не переполнил стек
+    void Release(Node* node) noexcept {
+        // acq_rel: все обращения других владельцев к узлу должны завершиться до его разрушения
+        while (node != nullptr && node->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Node* next = node->next_node;
+            NodeTraits::destroy(Alloc(), node);
+            NodeTraits::deallocate(Alloc(), node, 1);
+            node = next;
+        }
+    }
+
+    Head head_;
+    size_t size_ = 0;
+};
+
+template <typename Type, typename Allocator>
+void swap(PersistentSingleLinkedList<Type, Allocator>& lhs, PersistentSingleLinkedList<Type, Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename Type, typename Allocator>
+[[nodiscard]] bool operator==(const PersistentSingleLinkedList<Type, Allocator>& lhs,
+                              const PersistentSingleLinkedList<Type, Allocator>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, typename Allocator>
+[[nodiscard]] bool operator!=(const PersistentSingleLinkedList<Type, Allocator>& lhs,
+                              const PersistentSingleLinkedList<Type, Allocator>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Allocator>
+[[nodiscard]] bool operator<(const PersistentSingleLinkedList<Type, Allocator>& lhs,
+                             const PersistentSingleLinkedList<Type, Allocator>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, typename Allocator>
+[[nodiscard]] bool operator<=(const PersistentSingleLinkedList<Type, Allocator>& lhs,
+                              const PersistentSingleLinkedList<Type, Allocator>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename Allocator>
+[[nodiscard]] bool operator>(const PersistentSingleLinkedList<Type, Allocator>& lhs,
+                             const PersistentSingleLinkedList<Type, Allocator>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename Allocator>
+[[nodiscard]] bool operator>=(const PersistentSingleLinkedList<Type, Allocator>& lhs,
+                              const PersistentSingleLinkedList<Type, Allocator>& rhs) {
+    return !(lhs < rhs);
+}
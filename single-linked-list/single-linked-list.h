@@ -1,10 +1,1615 @@
 #pragma once
 
-// добавьте неоходимые include-директивы сюда
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
-template <typename Type>
-class SingleLinkedList {
-	// напишите код класса тут
+#include "background-reclaimer.h"
+#include "list-stats.h"
+#include "work-stealing-pool.h"
+
+namespace detail {
+
+// Аллокатор умеет освобождать всю свою память разом (см. PoolAllocator)
+template <typename Allocator, typename = void>
+struct SupportsBulkRelease : std::false_type {};
+
+template <typename Allocator>
+struct SupportsBulkRelease<Allocator, std::void_t<
+    decltype(std::declval<const Allocator&>().IsExclusive()),
+    decltype(std::declval<Allocator&>().ReleaseAll())>> : std::true_type {};
+
+// Аллокатор умеет выделять подряд идущие объекты, освобождаемые по одному (см. PoolAllocator)
+template <typename Allocator, typename = void>
+struct SupportsBatchAllocation : std::false_type {};
+
+template <typename Allocator>
+struct SupportsBatchAllocation<Allocator, std::void_t<
+    decltype(std::declval<Allocator&>().AllocateBatch(size_t{}))>> : std::true_type {};
+
+// Аллокатор умеет принять обратно цепочку объектов целиком (см. PoolAllocator)
+template <typename Allocator, typename = void>
+struct SupportsChainDeallocation : std::false_type {};
+
+template <typename Allocator>
+struct SupportsChainDeallocation<Allocator, std::void_t<
+    decltype(std::declval<Allocator&>().DeallocateChain(
+        std::declval<typename Allocator::value_type*>(), std::declval<typename Allocator::value_type*>()))>>
+    : std::true_type {};
+
+// Iter - итератор, из которого можно читать значения
+template <typename Iter>
+using RequireInputIterator = std::enable_if_t<std::is_convertible_v<
+    typename std::iterator_traits<Iter>::iterator_category, std::input_iterator_tag>>;
+
+template <typename Iter>
+inline constexpr bool IS_FORWARD_ITERATOR = std::is_convertible_v<
+    typename std::iterator_traits<Iter>::iterator_category, std::forward_iterator_tag>;
+
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Запрашивает предвыборку в кэш всех строк объекта размера size по адресу ptr
+inline void PrefetchObject(const void* ptr, size_t size) noexcept {
+#if defined(__GNUC__)
+    const char* bytes = static_cast<const char*>(ptr);
+    for (size_t offset = 0; offset < size; offset += CACHE_LINE_SIZE) {
+        __builtin_prefetch(bytes + offset);
+    }
+#else
+    (void)ptr;
+    (void)size;
+#endif
+}
+
+// Встроенный в объект списка буфер на Count узлов размера SlotSize.
+// Слоты раздаются подряд, освобождённые слоты попадают в список свободных (как в NodePool)
+template <size_t SlotSize, size_t SlotAlign, size_t Count>
+class InlineNodeSlots {
+public:
+    InlineNodeSlots() = default;
+    InlineNodeSlots(const InlineNodeSlots&) = delete;
+    InlineNodeSlots& operator=(const InlineNodeSlots&) = delete;
+
+    // Возвращает свободный слот либо nullptr, если буфер заполнен
+    [[nodiscard]] void* TryAllocate() noexcept {
+        if (free_list_ != nullptr) {
+            FreeSlot* slot = free_list_;
+            free_list_ = slot->next;
+            ++used_;
+            return slot;
+        }
+        if (bumped_ == Count) {
+            return nullptr;
+        }
+        ++used_;
+        return storage_ + SlotSize * bumped_++;
+    }
+
+    void Deallocate(void* ptr) noexcept {
+        assert(Owns(ptr));
+        FreeSlot* slot = static_cast<FreeSlot*>(ptr);
+        slot->next = free_list_;
+        free_list_ = slot;
+        --used_;
+    }
+
+    [[nodiscard]] bool Owns(const void* ptr) const noexcept {
+        return std::greater_equal<const void*>{}(ptr, storage_)
+            && std::less<const void*>{}(ptr, storage_ + sizeof(storage_));
+    }
+
+    [[nodiscard]] size_t Used() const noexcept {
+        return used_;
+    }
+
+    [[nodiscard]] size_t Free() const noexcept {
+        return Count - used_;
+    }
+
+    // Помечает все слоты свободными. Объекты в слотах должны быть уже разрушены
+    void Reset() noexcept {
+        free_list_ = nullptr;
+        bumped_ = 0;
+        used_ = 0;
+    }
+
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    alignas(SlotAlign) unsigned char storage_[SlotSize * Count];
+    FreeSlot* free_list_ = nullptr;
+    size_t bumped_ = 0;
+    size_t used_ = 0;
+};
+
+// Без встроенных слотов все узлы выделяет аллокатор, а буфер не занимает места
+template <size_t SlotSize, size_t SlotAlign>
+class InlineNodeSlots<SlotSize, SlotAlign, 0> {
+public:
+    [[nodiscard]] void* TryAllocate() noexcept {
+        return nullptr;
+    }
+
+    void Deallocate(void*) noexcept {
+    }
+
+    [[nodiscard]] bool Owns(const void*) const noexcept {
+        return false;
+    }
+
+    [[nodiscard]] size_t Used() const noexcept {
+        return 0;
+    }
+
+    [[nodiscard]] size_t Free() const noexcept {
+        return 0;
+    }
+
+    void Reset() noexcept {
+    }
+};
+
+}  // namespace detail
+
+// Очередь, узлы которой передаются списку без копирования, см. mpsc-queue.h
+template <typename Type, typename Allocator>
+class MpscQueue;
+
+// Stats - политика сбора статистики (NoListStats или ListStats).
+// Список наследуется от неё, чтобы пустая политика не занимала места.
+// InlineNodes - число узлов, которые хранятся прямо в объекте списка. Пока они не заняты,
+// вставка не обращается к аллокатору. Обмен и перемещение таких списков переносят
+// значения встроенных узлов, поэтому занимают время, пропорциональное позиции последнего из них
+template <typename Type, typename Allocator = std::allocator<Type>, typename Stats = NoListStats, size_t InlineNodes = 0>
+class SingleLinkedList : private Stats {
+    static_assert(InlineNodes == 0 || std::is_nothrow_move_constructible_v<Type>,
+                  "Встроенные узлы переносятся при обмене списков, поэтому перемещение Type не должно бросать исключений");
+
+    // Очередь создаёт узлы этого списка и передаёт их цепочкой в DrainInto
+    template <typename, typename>
+    friend class MpscQueue;
+
+    // Связь узла со следующим узлом. Фиктивный узел списка состоит только из неё,
+    // поэтому пустой список не создаёт ни одного значения Type
+    struct NodeBase {
+        NodeBase* next_node = nullptr;
+    };
+
+    // Узел списка
+    struct Node : NodeBase {
+        // Конструирует значение узла на месте из аргументов args
+        template <typename... Args>
+        Node(std::in_place_t, NodeBase* next, Args&&... args)
+            : NodeBase{ next }
+            , value(std::forward<Args>(args)...) {
+        }
+        Type value;
+    };
+
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    using InlineSlots = detail::InlineNodeSlots<sizeof(Node), alignof(Node), InlineNodes>;
+
+    // Фиктивный узел. Аллокатор и встроенные слоты хранятся в нём как базы,
+    // чтобы аллокатор без состояния и пустой буфер не занимали места в списке
+    struct Sentinel : NodeAllocator, NodeBase, InlineSlots {
+        Sentinel() = default;
+
+        explicit Sentinel(const NodeAllocator& alloc) noexcept
+            : NodeAllocator(alloc) {
+        }
+    };
+
+    // Значение узла, на который указывает node. node не должен быть фиктивным узлом
+    [[nodiscard]] static Type& ValueOf(NodeBase* node) noexcept {
+        return static_cast<Node*>(node)->value;
+    }
+
+    // Шаблон класса Базовый Итератор.
+    // Определяет поведение итератора на элементы односвязного списка
+    // ValueType - совпадает с Type (для Iterator) либо с const Type (для ConstIterator)
+    template <typename ValueType>
+    class BasicIterator {
+        // Класс списка объявляется дружественным, чтобы из методов списка
+        // был доступ к приватной области итератора
+        friend class SingleLinkedList;
+
+        // Конвертирующий конструктор итератора из указателя на узел списка
+        explicit BasicIterator(NodeBase* node) {
+            //assert(false);
+            // Реализуйте конструктор самостоятельно
+            node_ = node;
+        }
+
+    public:
+        // Объявленные ниже типы сообщают стандартной библиотеке о свойствах этого итератора
+
+        // Категория итератора - forward iterator
+        // (итератор, который поддерживает операции инкремента и многократное разыменование)
+        using iterator_category = std::forward_iterator_tag;
+        // Тип элементов, по которым перемещается итератор
+        using value_type = Type;
+        // Тип, используемый для хранения смещения между итераторами
+        using difference_type = std::ptrdiff_t;
+        // Тип указателя на итерируемое значение
+        using pointer = ValueType*;
+        // Тип ссылки на итерируемое значение
+        using reference = ValueType&;
+
+        BasicIterator() = default;
+
+        // Конвертирующий конструктор/конструктор копирования
+        // При ValueType, совпадающем с Type, играет роль копирующего конструктора
+        // При ValueType, совпадающем с const Type, играет роль конвертирующего конструктора
+        BasicIterator(const BasicIterator<Type>& other) noexcept {
+            node_ = other.node_;
+        }
+
+        // Чтобы компилятор не выдавал предупреждение об отсутствии оператора = при наличии
+        // пользовательского конструктора копирования, явно объявим оператор = и
+        // попросим компилятор сгенерировать его за нас.
+        BasicIterator& operator=(const BasicIterator& rhs) = default;
+
+        // Оператор сравнения итераторов (в роли второго аргумента выступает константный итератор)
+        // Два итератора равны, если они ссылаются на один и тот же элемент списка, либо на end()
+        [[nodiscard]] bool operator==(const BasicIterator<const Type>& rhs) const noexcept {
+            return this->node_ == rhs.node_;
+        }
+
+        // Оператор проверки итераторов на неравенство
+        // Противоположен !=
+        [[nodiscard]] bool operator!=(const BasicIterator<const Type>& rhs) const noexcept {
+            return this->node_ != rhs.node_;
+        }
+
+        // Оператор сравнения итераторов (в роли второго аргумента итератор)
+        // Два итератора равны, если они ссылаются на один и тот же элемент списка, либо на end()
+        [[nodiscard]] bool operator==(const BasicIterator<Type>& rhs) const noexcept {
+            return this->node_ == rhs.node_;
+        }
+
+        // Оператор проверки итераторов на неравенство
+        // Противоположен !=
+        [[nodiscard]] bool operator!=(const BasicIterator<Type>& rhs) const noexcept {
+            return this->node_ != rhs.node_;
+        }
+
+        // Оператор прединкремента. После его вызова итератор указывает на следующий элемент списка
+        // Возвращает ссылку на самого себя
+        // Инкремент итератора, не указывающего на существующий элемент списка, приводит к неопределённому поведению
+        BasicIterator& operator++() noexcept {
+            //assert(false);
+            // Заглушка. Реализуйте оператор самостоятельно
+            node_ = node_->next_node;
+            return *this;
+        }
+
+        // Оператор постинкремента. После его вызова итератор указывает на следующий элемент списка.
+        // Возвращает прежнее значение итератора
+        // Инкремент итератора, не указывающего на существующий элемент списка,
+        // приводит к неопределённому поведению
+        BasicIterator operator++(int) noexcept {
+            //assert(false);
+            // Заглушка. Реализуйте оператор самостоятельно
+            auto old_value(*this);
+            node_ = node_->next_node;
+            return old_value;
+        }
+
+        // Операция разыменования. Возвращает ссылку на текущий элемент
+        // Вызов этого оператора у итератора, не указывающего на существующий элемент списка,
+        // приводит к неопределённому поведению
+        [[nodiscard]] reference operator*() const noexcept {
+            return ValueOf(node_);
+        }
+
+        // Операция доступа к члену класса. Возвращает указатель на текущий элемент списка.
+        // Вызов этого оператора у итератора, не указывающего на существующий элемент списка,
+        // приводит к неопределённому поведению
+        [[nodiscard]] pointer operator->() const noexcept {
+            assert(node_ != nullptr);
+            return &ValueOf(node_);
+        }
+
+    private:
+        NodeBase* node_ = nullptr;
+    };
+
+    // Итератор, который помимо текущего узла ведёт указатель на узел, стоящий на несколько позиций впереди,
+    // и запрашивает его предвыборку. Пока обрабатываются текущие элементы, следующие узлы уже загружаются в кэш
+    template <typename ValueType>
+    class PrefetchingIterator {
+        friend class SingleLinkedList;
+
+        PrefetchingIterator(NodeBase* node, size_t distance) noexcept
+            : node_(node)
+            , ahead_(node) {
+            for (size_t i = 0; i < distance && ahead_ != nullptr; ++i) {
+                ahead_ = ahead_->next_node;
+                Prefetch(ahead_);
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueType*;
+        using reference = ValueType&;
+
+        PrefetchingIterator() = default;
+
+        [[nodiscard]] bool operator==(const PrefetchingIterator& rhs) const noexcept {
+            return node_ == rhs.node_;
+        }
+
+        [[nodiscard]] bool operator!=(const PrefetchingIterator& rhs) const noexcept {
+            return node_ != rhs.node_;
+        }
+
+        PrefetchingIterator& operator++() noexcept {
+            node_ = node_->next_node;
+            if (ahead_ != nullptr) {
+                ahead_ = ahead_->next_node;
+                Prefetch(ahead_);
+            }
+            return *this;
+        }
+
+        PrefetchingIterator operator++(int) noexcept {
+            auto old_value(*this);
+            ++*this;
+            return old_value;
+        }
+
+        [[nodiscard]] reference operator*() const noexcept {
+            return ValueOf(node_);
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept {
+            assert(node_ != nullptr);
+            return &ValueOf(node_);
+        }
+
+    private:
+        static void Prefetch(NodeBase* node) noexcept {
+            if (node != nullptr) {
+                detail::PrefetchObject(node, sizeof(Node));
+            }
+        }
+
+        NodeBase* node_ = nullptr;
+        NodeBase* ahead_ = nullptr;
+    };
+
+    // Диапазон для обхода списка итераторами PrefetchingIterator
+    template <typename ValueType>
+    class PrefetchingRange {
+        friend class SingleLinkedList;
+
+        PrefetchingRange(NodeBase* first, size_t distance) noexcept
+            : first_(first)
+            , distance_(distance) {
+        }
+
+    public:
+        [[nodiscard]] PrefetchingIterator<ValueType> begin() const noexcept {
+            return PrefetchingIterator<ValueType>(first_, distance_);
+        }
+
+        [[nodiscard]] PrefetchingIterator<ValueType> end() const noexcept {
+            return PrefetchingIterator<ValueType>(nullptr, 0);
+        }
+
+    private:
+        NodeBase* first_;
+        size_t distance_;
+    };
+
+public:
+    SingleLinkedList() {
+    }
+
+    explicit SingleLinkedList(const Allocator& alloc)
+        : head_(alloc) {
+    }
+
+    // Возвращает количество элементов в списке за время O(1)
+    [[nodiscard]] size_t GetSize() const noexcept {
+        // Заглушка. Реализуйте метод самостоятельно
+        return size_;
+        //assert(false);
+        //return 42;
+    }
+
+    // Сообщает, пустой ли список за время O(1)
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        // Заглушка. Реализуйте метод самостоятельно
+        if (size_ != 0) {
+            return false;
+        }
+        return true;
+    }
+
+    // Вставляет элемент value в начало списка за время O(1)
+    void PushFront(const Type& value) {
+        // Реализуйте метод самостоятельно
+        EmplaceFront(value);
+    }
+
+    // Вставляет элемент value в начало списка за время O(1), перемещая его в узел
+    void PushFront(Type&& value) {
+        EmplaceFront(std::move(value));
+    }
+
+    // Конструирует элемент в начале списка из аргументов args за время O(1)
+    // Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    Type& EmplaceFront(Args&&... args) {
+        return *EmplaceAfter(cbefore_begin(), std::forward<Args>(args)...);
+    }
+
+    // Вставляет элемент value в конец списка за время O(1)
+    void PushBack(const Type& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(Type&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    // Конструирует элемент в конце списка из аргументов args за время O(1)
+    // Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return *EmplaceAfter(ConstIterator{ tail_ }, std::forward<Args>(args)...);
+    }
+
+    // Возвращает ссылку на последний элемент за время O(1)
+    // Вызов у пустого списка приводит к неопределённому поведению
+    [[nodiscard]] Type& back() noexcept {
+        assert(!IsEmpty());
+        return ValueOf(tail_);
+    }
+
+    [[nodiscard]] const Type& back() const noexcept {
+        assert(!IsEmpty());
+        return ValueOf(tail_);
+    }
+
+    // Переносит все элементы other в конец списка, other становится пустым.
+    // При равных аллокаторах узлы перецепляются за время O(1),
+    // иначе элементы перемещаются в узлы этого списка за время O(N)
+    void SpliceBack(SingleLinkedList& other) {
+        SpliceAfter(ConstIterator{ tail_ }, other);
+    }
+
+    /*
+     * Очищает список за время O(N).
+     * Если пул аллокатора принадлежит только этому списку, память узлов освобождается
+     * целыми блоками, а для тривиально разрушаемого Type узлы даже не обходятся.
+     * Если пул общий, а Type тривиально разрушаем, вся цепочка возвращается в пул за время O(1)
+     */
+    void Clear() noexcept {
+        [[maybe_unused]] auto timer = StatsPolicy().Time(ListOperation::CLEAR);
+        StatsPolicy().OnFree(size_);
+        NodeBase* first = std::exchange(head_.next_node, nullptr);
+        NodeBase* last = std::exchange(tail_, &head_);
+        size_ = 0;
+        if (first == nullptr) {
+            return;
+        }
+        if constexpr (detail::SupportsBulkRelease<NodeAllocator>::value) {
+            if (Alloc().IsExclusive()) {
+                if constexpr (!std::is_trivially_destructible_v<Type>) {
+                    for (NodeBase* node = first; node != nullptr;) {
+                        NodeBase* next = node->next_node;
+                        NodeTraits::destroy(Alloc(), static_cast<Node*>(node));
+                        node = next;
+                    }
+                }
+                Alloc().ReleaseAll();
+                Slots().Reset();
+                return;
+            }
+        }
+        if constexpr (std::is_trivially_destructible_v<Type>
+                      && detail::SupportsChainDeallocation<NodeAllocator>::value) {
+            // Ссылка на следующий узел лежит в начале узла, поэтому цепочка
+            // узлов уже является готовым списком свободных слотов пула
+            assert(static_cast<void*>(static_cast<Node*>(first)) == static_cast<void*>(first));
+            if (Slots().Used() == 0 && Alloc().DeallocateChain(static_cast<Node*>(first), static_cast<Node*>(last))) {
+                return;
+            }
+        }
+        ReleaseChain(first);
+    }
+
+    /*
+     * Очищает список, передавая разрушение элементов и освобождение узлов фоновому потоку
+     * BackgroundReclaimer. Список становится пустым за время O(1).
+     * Деструктор Type должен допускать вызов из другого потока.
+     * Аллокаторы с состоянием (например, PoolAllocator) не потокобезопасны, как и узлы
+     * во встроенных слотах списка, поэтому для них выполняется обычный Clear
+     */
+    void ClearAsync() noexcept {
+        if constexpr (NodeTraits::is_always_equal::value && InlineNodes == 0) {
+            if (IsEmpty()) {
+                return;
+            }
+            StatsPolicy().OnFree(size_);
+            NodeBase* first = std::exchange(head_.next_node, nullptr);
+            tail_ = &head_;
+            size_ = 0;
+            try {
+                BackgroundReclaimer::Instance().Submit([first, alloc = Alloc()]() mutable noexcept {
+                    for (NodeBase* node = first; node != nullptr;) {
+                        Node* current = static_cast<Node*>(node);
+                        node = node->next_node;
+                        NodeTraits::destroy(alloc, current);
+                        NodeTraits::deallocate(alloc, current, 1);
+                    }
+                });
+            } catch (...) {
+                // Очередь не смогла принять задачу, узлы освобождаются в этом потоке
+                ReleaseChain(first);
+            }
+        } else {
+            Clear();
+        }
+    }
+
+    ~SingleLinkedList() {
+        Clear();
+    }
+
+    using value_type = Type;
+    using allocator_type = Allocator;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    // Итератор, допускающий изменение элементов списка
+    using Iterator = BasicIterator<Type>;
+    // Константный итератор, предоставляющий доступ для чтения к элементам списка
+    using ConstIterator = BasicIterator<const Type>;
+
+    // Возвращает итератор, ссылающийся на первый элемент
+    // Если список пустой, возвращённый итератор будет равен end()
+    [[nodiscard]] Iterator begin() noexcept {
+        //assert(false);
+        // Реализуйте самостоятельно
+        return Iterator{ head_.next_node };
+    }
+
+    // Возвращает итератор, указывающий на позицию, следующую за последним элементом односвязного списка
+    // Разыменовывать этот итератор нельзя - попытка разыменования приведёт к неопределённому поведению
+    [[nodiscard]] Iterator end() noexcept {
+        //assert(false);
+        // Реализуйте самостоятельно
+        return Iterator{ nullptr };
+    }
+
+    // Возвращает константный итератор, ссылающийся на первый элемент
+    // Если список пустой, возвращённый итератор будет равен end()
+    // Результат вызова эквивалентен вызову метода cbegin()
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        //assert(false);
+        // Реализуйте самостоятельно
+        return ConstIterator{ head_.next_node };
+    }
+
+    // Возвращает константный итератор, указывающий на позицию, следующую за последним элементом односвязного списка
+    // Разыменовывать этот итератор нельзя - попытка разыменования приведёт к неопределённому поведению
+    // Результат вызова эквивалентен вызову метода cend()
+    [[nodiscard]] ConstIterator end() const noexcept {
+        //assert(false);
+        // Реализуйте самостоятельно
+        return ConstIterator{ nullptr };
+    }
+
+    // Возвращает константный итератор, ссылающийся на первый элемент
+    // Если список пустой, возвращённый итератор будет равен cend()
+    [[nodiscard]] ConstIterator cbegin() const noexcept {
+        //assert(false);
+        // Реализуйте самостоятельно
+        return ConstIterator{ head_.next_node };
+    }
+
+    // Возвращает константный итератор, указывающий на позицию, следующую за последним элементом односвязного списка
+    // Разыменовывать этот итератор нельзя - попытка разыменования приведёт к неопределённому поведению
+    [[nodiscard]] ConstIterator cend() const noexcept {
+        //assert(false);
+        // Реализуйте самостоятельно
+        return ConstIterator{ nullptr };
+    }
+    template<typename Iter>
+    void copy_it(const Iter begin, const Iter end) {
+        [[maybe_unused]] auto timer = StatsPolicy().Time(ListOperation::COPY);
+        SingleLinkedList temp(Alloc());
+        temp.AppendRange(begin, end);
+        StatsPolicy().OnAllocate(temp.size_);
+        StatsPolicy().OnCopy(temp.size_);
+        swap(temp);
+        StatsPolicy().OnFree(temp.size_);
+    }
+
+    // Создаёт список из элементов диапазона [first, last)
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    SingleLinkedList(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+        : head_(alloc) {
+        copy_it(first, last);
+    }
+
+    // Создаёт список из count копий value
+    SingleLinkedList(size_t count, const Type& value, const Allocator& alloc = Allocator())
+        : head_(alloc) {
+        AppendCopies(count, value);
+        StatsPolicy().OnCopy(count);
+    }
+
+    // Заменяет содержимое списка элементами диапазона [first, last)
+    // Если при копировании будет выброшено исключение, список останется в прежнем состоянии
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    void Assign(InputIt first, InputIt last) {
+        copy_it(first, last);
+    }
+
+    // Заменяет содержимое списка count копиями value
+    void Assign(size_t count, const Type& value) {
+        [[maybe_unused]] auto timer = StatsPolicy().Time(ListOperation::COPY);
+        SingleLinkedList temp(Alloc());
+        temp.AppendCopies(count, value);
+        StatsPolicy().OnAllocate(temp.size_);
+        StatsPolicy().OnCopy(temp.size_);
+        swap(temp);
+        StatsPolicy().OnFree(temp.size_);
+    }
+ 
+    SingleLinkedList(const SingleLinkedList& other)
+        : head_(NodeTraits::select_on_container_copy_construction(other.Alloc())) {
+        copy_it(other.begin(), other.end());
+    }
+ 
+    SingleLinkedList(const std::initializer_list<Type> i_list, const Allocator& alloc = Allocator())
+        : head_(alloc) {
+        copy_it(i_list.begin(), i_list.end());
+    }
+
+    // Перемещающий конструктор забирает узлы other за время O(1), не копируя элементы.
+    // other остаётся пустым и пригодным к использованию
+    SingleLinkedList(SingleLinkedList&& other) noexcept
+        : head_(other.Alloc()) {
+        swap(other);
+    }
+
+    // Копирует элементы rhs в узлы собственного аллокатора списка
+    SingleLinkedList& operator=(const SingleLinkedList& rhs) {
+        if (this != &rhs){
+            copy_it(rhs.begin(), rhs.end());
+        }
+        return *this;
+    }
+
+    SingleLinkedList& operator=(SingleLinkedList&& rhs) noexcept {
+        if (this != &rhs) {
+            SingleLinkedList rhs2(std::move(rhs));
+            swap(rhs2);
+        }
+        return *this;
+    }
+
+    // Обменивает содержимое списков за время O(1)
+    void swap(SingleLinkedList& other) noexcept {
+        std::swap(other.head_.next_node, head_.next_node);
+        std::swap(other.size_, size_);
+        std::swap(other.Alloc(), Alloc());
+        std::swap(other.tail_, tail_);
+        // Пустой список хранит в tail_ адрес собственного фиктивного узла
+        if (tail_ == &other.head_) {
+            tail_ = &head_;
+        }
+        if (other.tail_ == &head_) {
+            other.tail_ = &other.head_;
+        }
+        if constexpr (InlineNodes > 0) {
+            ExchangeInlineNodes(other);
+        }
+        // Статистика остаётся у объекта списка, меняется только содержимое
+        StatsPolicy().OnSize(size_);
+        other.StatsPolicy().OnSize(other.size_);
+    }
+
+    // Политика статистики списка. Для ListStats снимок счётчиков возвращает GetStats().Snapshot()
+    [[nodiscard]] const Stats& GetStats() const noexcept {
+        return *this;
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept {
+        return allocator_type(Alloc());
+    }
+    
+    [[nodiscard]] Iterator before_begin() noexcept {
+        // Реализуйте самостоятельно
+        return Iterator{&head_};
+    }
+
+    // Возвращает константный итератор, указывающий на позицию перед первым элементом односвязного списка.
+    // Разыменовывать этот итератор нельзя - попытка разыменования приведёт к неопределённому поведению
+    [[nodiscard]] ConstIterator cbefore_begin() const noexcept {
+        
+        return ConstIterator{ const_cast<Sentinel*>(&head_) };
+    }
+
+    // Возвращает константный итератор, указывающий на позицию перед первым элементом односвязного списка.
+    // Разыменовывать этот итератор нельзя - попытка разыменования приведёт к неопределённому поведению
+    [[nodiscard]] ConstIterator before_begin() const noexcept {
+        // Реализуйте самостоятельно
+        return cbefore_begin();
+    }
+
+    static constexpr size_t DEFAULT_PREFETCH_DISTANCE = 4;
+
+    // Возвращает диапазон для обхода списка с программной предвыборкой узлов на distance позиций вперёд:
+    // for (auto& value : list.Prefetched()) { ... }
+    // Ускоряет обход, когда узлы разбросаны по памяти, а обработка элемента занимает заметное время
+    [[nodiscard]] PrefetchingRange<Type> Prefetched(size_t distance = DEFAULT_PREFETCH_DISTANCE) noexcept {
+        return PrefetchingRange<Type>(head_.next_node, distance);
+    }
+
+    [[nodiscard]] PrefetchingRange<const Type> Prefetched(size_t distance = DEFAULT_PREFETCH_DISTANCE) const noexcept {
+        return PrefetchingRange<const Type>(head_.next_node, distance);
+    }
+
+    /*
+     * Вставляет элемент value после элемента, на который указывает pos.
+     * Возвращает итератор на вставленный элемент
+     * Если при создании элемента будет выброшено исключение, список останется в прежнем состоянии
+     */
+    Iterator InsertAfter(ConstIterator pos, const Type& value) {
+        // Заглушка. Реализуйте метод самостоятельно
+        return EmplaceAfter(pos, value);
+    }
+
+    Iterator InsertAfter(ConstIterator pos, Type&& value) {
+        return EmplaceAfter(pos, std::move(value));
+    }
+
+    /*
+     * Вставляет элементы диапазона [first, last) после элемента, на который указывает pos.
+     * Цепочка узлов создаётся целиком и присоединяется к списку за одну операцию.
+     * Возвращает итератор на последний вставленный элемент либо pos, если диапазон пуст
+     * Если при создании элемента будет выброшено исключение, список останется в прежнем состоянии
+     */
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    Iterator InsertAfter(ConstIterator pos, InputIt first, InputIt last) {
+        SingleLinkedList chain(Alloc());
+        chain.AppendRange(first, last);
+        StatsPolicy().OnAllocate(chain.size_);
+        AdoptInlineNodes(chain, &chain.head_, nullptr);
+        return LinkChainAfter(pos.node_, chain);
+    }
+
+    // Вставляет count копий value после элемента, на который указывает pos
+    Iterator InsertAfter(ConstIterator pos, size_t count, const Type& value) {
+        SingleLinkedList chain(Alloc());
+        chain.AppendCopies(count, value);
+        StatsPolicy().OnAllocate(chain.size_);
+        AdoptInlineNodes(chain, &chain.head_, nullptr);
+        return LinkChainAfter(pos.node_, chain);
+    }
+
+    /*
+     * Конструирует элемент из аргументов args после элемента, на который указывает pos.
+     * Возвращает итератор на вставленный элемент
+     * Если при создании элемента будет выброшено исключение, список останется в прежнем состоянии
+     */
+    template <typename... Args>
+    Iterator EmplaceAfter(ConstIterator pos, Args&&... args) {
+        pos.node_->next_node = CreateNode(pos.node_->next_node, std::forward<Args>(args)...);
+        if (pos.node_ == tail_) {
+            tail_ = pos.node_->next_node;
+        }
+        ++size_;
+        StatsPolicy().OnSize(size_);
+        return Iterator(pos.node_->next_node);
+    }
+
+    /*
+     * Переносит все элементы other после элемента, на который указывает pos, other становится пустым.
+     * При равных аллокаторах узлы перецепляются за время O(1) без копирования элементов,
+     * иначе элементы перемещаются в новые узлы этого списка за время O(N)
+     */
+    void SpliceAfter(ConstIterator pos, SingleLinkedList& other) {
+        if (this == &other || other.IsEmpty()) {
+            return;
+        }
+        if (Alloc() == other.Alloc()) {
+            // Длина и последний узел other известны, поэтому цепочку не нужно обходить
+            AdoptInlineNodes(other, &other.head_, nullptr);
+            StatsPolicy().OnSplice();
+            LinkChainAfter(pos.node_, other);
+            return;
+        }
+        SpliceAfter(pos, other, other.cbefore_begin(), other.cend());
+    }
+
+    // Переносит из other элемент, следующий за it, и вставляет его после pos
+    void SpliceAfter(ConstIterator pos, SingleLinkedList& other, ConstIterator it) {
+        ConstIterator next = it;
+        ++next;
+        if (pos == it || pos == next) {
+            return;
+        }
+        SpliceAfter(pos, other, it, ++next);
+    }
+
+    /*
+     * Переносит из other элементы интервала (first, last) и вставляет их после pos.
+     * Узлы перецепляются без копирования элементов, но для подсчёта их числа
+     * интервал проходится за время, пропорциональное его длине.
+     * pos не должен лежать внутри интервала. other может совпадать с этим списком
+     */
+    void SpliceAfter(ConstIterator pos, SingleLinkedList& other, ConstIterator first, ConstIterator last) {
+        if (first.node_->next_node == last.node_) {
+            return;
+        }
+        if (Alloc() == other.Alloc()) {
+            AdoptInlineNodes(other, first.node_, last.node_);
+        }
+        NodeBase* first_node = first.node_->next_node;
+        NodeBase* last_node = first_node;
+        size_t count = 1;
+        while (last_node->next_node != last.node_) {
+            last_node = last_node->next_node;
+            ++count;
+        }
+
+        SingleLinkedList chain(Alloc());
+        if (Alloc() != other.Alloc()) {
+            for (NodeBase* node = first_node; node != last.node_; node = node->next_node) {
+                chain.EmplaceBack(std::move(ValueOf(node)));
+            }
+            AdoptInlineNodes(chain, &chain.head_, nullptr);
+            for (size_t i = 0; i < count; ++i) {
+                other.EraseAfter(first);
+            }
+            StatsPolicy().OnAllocate(count);
+            LinkChainAfter(pos.node_, chain);
+            return;
+        }
+        StatsPolicy().OnSplice();
+
+        first.node_->next_node = last.node_;
+        if (other.tail_ == last_node) {
+            other.tail_ = first.node_;
+        }
+        other.size_ -= count;
+
+        last_node->next_node = nullptr;
+        chain.head_.next_node = first_node;
+        chain.tail_ = last_node;
+        chain.size_ = count;
+        LinkChainAfter(pos.node_, chain);
+    }
+
+    // Отделяет элементы, следующие за pos, в новый список с тем же аллокатором.
+    // Узлы не копируются, время работы пропорционально длине отделяемой части
+    [[nodiscard]] SingleLinkedList SplitAfter(ConstIterator pos) {
+        SingleLinkedList rest(Alloc());
+        if (pos.node_->next_node == nullptr) {
+            return rest;
+        }
+        rest.AdoptInlineNodes(*this, pos.node_, nullptr);
+        NodeBase* first_node = pos.node_->next_node;
+        size_t count = 0;
+        for (NodeBase* node = first_node; node != nullptr; node = node->next_node) {
+            ++count;
+        }
+        StatsPolicy().OnSplice();
+        pos.node_->next_node = nullptr;
+        rest.head_.next_node = first_node;
+        rest.tail_ = tail_;
+        rest.size_ = count;
+        tail_ = pos.node_;
+        size_ -= count;
+        return rest;
+    }
+
+    void PopFront() noexcept {
+        // Реализуйте метод самостоятельно
+        if(head_.next_node != nullptr){
+        NodeBase* new_head = head_.next_node->next_node;
+        DestroyNode(head_.next_node);
+        head_.next_node = new_head;
+        --size_;
+        if (new_head == nullptr) {
+            tail_ = &head_;
+        }
+        }
+    }
+
+    /*
+     * Удаляет элемент, следующий за pos.
+     * Возвращает итератор на элемент, следующий за удалённым
+     */
+    Iterator EraseAfter(ConstIterator pos) noexcept {
+        
+        if (head_.next_node != nullptr){
+            NodeBase* temp = pos.node_->next_node->next_node;
+            if (pos.node_->next_node == tail_) {
+                tail_ = pos.node_;
+            }
+            DestroyNode(pos.node_->next_node);
+            pos.node_->next_node = temp;
+            --size_;
+        }
+        return Iterator{pos.node_->next_node};
+    }
+
+    /*
+     * Сортирует список восходящей сортировкой слиянием за время O(N log N).
+     * Узлы перецепляются, элементы не копируются и память не выделяется. Сортировка устойчива.
+     * Если comp выбросит исключение, все элементы останутся в списке в неопределённом порядке
+     */
+    template <typename Compare>
+    void Sort(Compare comp) {
+        if (size_ < 2) {
+            return;
+        }
+        [[maybe_unused]] auto timer = StatsPolicy().Time(ListOperation::SORT);
+        // В buckets[i] хранится отсортированная цепочка из 2^i узлов или nullptr.
+        // Чем больше i, тем раньше в списке стояли элементы цепочки
+        NodeBase* buckets[std::numeric_limits<size_t>::digits] = {};
+        NodeBase* rest = head_.next_node;
+        NodeBase* carry = nullptr;
+        NodeBase* sorted = nullptr;
+        try {
+            while (rest != nullptr) {
+                carry = rest;
+                rest = rest->next_node;
+                carry->next_node = nullptr;
+                size_t i = 0;
+                for (; buckets[i] != nullptr; ++i) {
+                    MergeChains(buckets[i], std::exchange(carry, nullptr), comp);
+                    carry = std::exchange(buckets[i], nullptr);
+                }
+                buckets[i] = std::exchange(carry, nullptr);
+            }
+            for (NodeBase*& bucket : buckets) {
+                if (bucket != nullptr) {
+                    MergeChains(bucket, std::exchange(sorted, nullptr), comp);
+                    sorted = std::exchange(bucket, nullptr);
+                }
+            }
+        } catch (...) {
+            // Собираем все цепочки обратно в список, чтобы не потерять узлы
+            NodeBase* chains = ConcatChains(sorted, ConcatChains(carry, rest));
+            for (NodeBase* bucket : buckets) {
+                chains = ConcatChains(bucket, chains);
+            }
+            head_.next_node = chains;
+            RestoreTail();
+            throw;
+        }
+        head_.next_node = sorted;
+        RestoreTail();
+    }
+
+    void Sort() {
+        Sort(std::less<>{});
+    }
+
+    /*
+     * Переносит элементы в новые узлы, расположенные в памяти подряд в порядке обхода списка,
+     * чтобы после множества вставок и удалений обход снова читал память последовательно.
+     * Если аллокатор умеет выделять участки (PoolAllocator), все узлы занимают один участок,
+     * иначе узлы запрашиваются у аллокатора по одному в порядке обхода.
+     * Итераторы и ссылки на элементы становятся недействительными.
+     * Если перемещение Type может выбросить исключение, элементы копируются,
+     * и при исключении список остаётся в прежнем состоянии
+     */
+    void Compact() {
+        if (size_ < 2) {
+            return;
+        }
+        [[maybe_unused]] auto timer = StatsPolicy().Time(ListOperation::COMPACT);
+        SingleLinkedList compact(Alloc());
+        NodeBase* source = head_.next_node;
+        compact.AppendNodes(size_, [this, &source](Node* node) {
+            NodeTraits::construct(Alloc(), node, std::in_place, nullptr, std::move_if_noexcept(ValueOf(source)));
+            source = source->next_node;
+        });
+        StatsPolicy().OnAllocate(compact.size_);
+        swap(compact);
+        StatsPolicy().OnFree(compact.size_);
+    }
+
+    // Параллельно вызывает fn(element) для каждого элемента на потоках общего пула.
+    // fn вызывается из нескольких потоков одновременно, но каждый элемент обрабатывается одним потоком
+    template <typename Fn>
+    void ForEach(Fn fn) {
+        ForEach(WorkStealingPool::Instance(), fn);
+    }
+
+    /*
+     * Параллельно вызывает fn(element) для каждого элемента на потоках пула pool.
+     * Список делится за один проход на участки почти равной длины, участков в несколько раз больше,
+     * чем потоков, чтобы освободившиеся потоки перехватывали работу у занятых.
+     * Если fn выбросит исключение, остаток его участка пропускается,
+     * а первое исключение выбрасывается после обработки остальных участков
+     */
+    template <typename Fn>
+    void ForEach(WorkStealingPool& pool, Fn fn) {
+        ForEachSegment(pool, [&fn](size_t, NodeBase* node, size_t count) {
+            for (; count > 0; --count, node = node->next_node) {
+                fn(ValueOf(node));
+            }
+        });
+    }
+
+    // Параллельно заменяет каждый элемент результатом fn(element)
+    template <typename Fn>
+    void TransformInPlace(Fn fn) {
+        TransformInPlace(WorkStealingPool::Instance(), fn);
+    }
+
+    template <typename Fn>
+    void TransformInPlace(WorkStealingPool& pool, Fn fn) {
+        ForEach(pool, [&fn](Type& value) {
+            value = fn(value);
+        });
+    }
+
+    // Параллельно сворачивает элементы операцией op, начиная с init. Требования к T и op - у перегрузки с пулом
+    template <typename T, typename BinaryOp>
+    [[nodiscard]] T Reduce(T init, BinaryOp op) const {
+        return Reduce(WorkStealingPool::Instance(), std::move(init), op);
+    }
+
+    /*
+     * Каждый участок сворачивается отдельно, начиная со своего первого элемента, приведённого к T,
+     * затем результаты участков сворачиваются с init в порядке следования участков.
+     * В отличие от последовательной свёртки от init, здесь:
+     *   T должен конструироваться из элемента списка;
+     *   op вызывается и как op(T, const Type&), и как op(T, T);
+     *   op должна быть ассоциативной на T, иначе результат зависит от границ участков.
+     * Порядок элементов сохраняется, поэтому перестановочной op быть не обязана
+     */
+    template <typename T, typename BinaryOp>
+    [[nodiscard]] T Reduce(WorkStealingPool& pool, T init, BinaryOp op) const {
+        static_assert(std::is_constructible_v<T, const Type&>, "Reduce: T must be constructible from the element type");
+        static_assert(std::is_invocable_r_v<T, BinaryOp&, T, T>, "Reduce: op must combine two partial results of type T");
+        std::vector<std::optional<T>> partials(SegmentCount(pool));
+        ForEachSegment(pool, [&partials, &op](size_t index, NodeBase* node, size_t count) {
+            std::optional<T>& partial = partials[index];
+            partial.emplace(ValueOf(node));
+            for (node = node->next_node, --count; count > 0; --count, node = node->next_node) {
+                *partial = op(std::move(*partial), ValueOf(node));
+            }
+        });
+        for (std::optional<T>& partial : partials) {
+            if (partial) {
+                init = op(std::move(init), std::move(*partial));
+            }
+        }
+        return init;
+    }
+
+    // Меняет порядок элементов на обратный за один проход
+    void Reverse() noexcept {
+        NodeBase* reversed = nullptr;
+        NodeBase* node = head_.next_node;
+        if (node != nullptr) {
+            tail_ = node;
+        }
+        while (node != nullptr) {
+            NodeBase* next = node->next_node;
+            node->next_node = reversed;
+            reversed = node;
+            node = next;
+        }
+        head_.next_node = reversed;
+    }
+
+    // Удаляет элементы, равные предыдущему, за один проход.
+    // Возвращает количество удалённых элементов
+    template <typename BinaryPredicate>
+    size_t Unique(BinaryPredicate equal) {
+        [[maybe_unused]] auto timer = StatsPolicy().Time(ListOperation::REMOVE);
+        const size_t old_size = size_;
+        NodeBase* node = head_.next_node;
+        while (node != nullptr && node->next_node != nullptr) {
+            if (equal(ValueOf(node), ValueOf(node->next_node))) {
+                EraseAfter(ConstIterator{ node });
+            } else {
+                node = node->next_node;
+            }
+        }
+        return old_size - size_;
+    }
+
+    size_t Unique() {
+        return Unique(std::equal_to<>{});
+    }
+
+    // Удаляет элементы, для которых pred возвращает true, за один проход.
+    // Возвращает количество удалённых элементов
+    template <typename Predicate>
+    size_t RemoveIf(Predicate pred) {
+        [[maybe_unused]] auto timer = StatsPolicy().Time(ListOperation::REMOVE);
+        const size_t old_size = size_;
+        NodeBase* prev = &head_;
+        while (prev->next_node != nullptr) {
+            if (pred(ValueOf(prev->next_node))) {
+                EraseAfter(ConstIterator{ prev });
+            } else {
+                prev = prev->next_node;
+            }
+        }
+        return old_size - size_;
+    }
+
+    /*
+     * Сливает отсортированный список other в этот отсортированный список за один проход.
+     * При равных элементах элементы этого списка идут первыми. other становится пустым.
+     * При равных аллокаторах узлы перецепляются без выделения памяти,
+     * иначе элементы other сначала перемещаются в узлы этого списка
+     */
+    template <typename Compare>
+    void Merge(SingleLinkedList& other, Compare comp) {
+        if (this == &other || other.IsEmpty()) {
+            return;
+        }
+        [[maybe_unused]] auto timer = StatsPolicy().Time(ListOperation::MERGE);
+        SingleLinkedList chain(Alloc());
+        if (Alloc() != other.Alloc()) {
+            for (Type& value : other) {
+                chain.EmplaceBack(std::move(value));
+            }
+            AdoptInlineNodes(chain, &chain.head_, nullptr);
+            other.Clear();
+            StatsPolicy().OnAllocate(chain.size_);
+        } else {
+            AdoptInlineNodes(other, &other.head_, nullptr);
+            chain.swap(other);
+            StatsPolicy().OnSplice();
+        }
+
+        NodeBase* other_tail = chain.tail_;
+        const size_t other_size = chain.size_;
+        NodeBase* other_head = std::exchange(chain.head_.next_node, nullptr);
+        chain.tail_ = &chain.head_;
+        chain.size_ = 0;
+
+        size_ += other_size;
+        StatsPolicy().OnSize(size_);
+        try {
+            if (MergeChains(head_.next_node, other_head, comp)) {
+                tail_ = other_tail;
+            }
+        } catch (...) {
+            RestoreTail();
+            throw;
+        }
+    }
+
+    void Merge(SingleLinkedList& other) {
+        Merge(other, std::less<>{});
+    }
+    
+private:
+    /*
+     * Сливает отсортированные цепочки dest и other, результат записывается в dest.
+     * При равных элементах узлы dest идут первыми.
+     * Возвращает true, если последний узел результата взят из other.
+     * Если comp выбросит исключение, в dest окажутся все узлы обеих цепочек
+     */
+    template <typename Compare>
+    static bool MergeChains(NodeBase*& dest, NodeBase* other, Compare& comp) {
+        NodeBase* a = dest;
+        NodeBase* b = other;
+        NodeBase* merged = nullptr;
+        NodeBase** link = &merged;
+        try {
+            while (a != nullptr && b != nullptr) {
+                if (comp(ValueOf(b), ValueOf(a))) {
+                    *link = b;
+                    b = b->next_node;
+                } else {
+                    *link = a;
+                    a = a->next_node;
+                }
+                link = &(*link)->next_node;
+            }
+        } catch (...) {
+            *link = ConcatChains(a, b);
+            dest = merged;
+            throw;
+        }
+        *link = a != nullptr ? a : b;
+        dest = merged;
+        return a == nullptr && b != nullptr;
+    }
+
+    // Присоединяет цепочку tail к концу цепочки head, возвращает начало результата
+    static NodeBase* ConcatChains(NodeBase* head, NodeBase* tail) noexcept {
+        if (head == nullptr) {
+            return tail;
+        }
+        NodeBase* last = head;
+        while (last->next_node != nullptr) {
+            last = last->next_node;
+        }
+        last->next_node = tail;
+        return head;
+    }
+
+    // Наименьшая длина участка при параллельной обработке и число участков на поток
+    static constexpr size_t PARALLEL_GRAIN = 64;
+    static constexpr size_t SEGMENTS_PER_THREAD = 4;
+
+    [[nodiscard]] size_t SegmentCount(const WorkStealingPool& pool) const noexcept {
+        const size_t by_grain = (size_ + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+        return std::min(by_grain, pool.GetConcurrency() * SEGMENTS_PER_THREAD);
+    }
+
+    // Делит список за один проход на SegmentCount участков, длины которых отличаются
+    // не больше чем на единицу, и параллельно вызывает segment_fn(номер, первый узел, длина)
+    template <typename SegmentFn>
+    void ForEachSegment(WorkStealingPool& pool, SegmentFn segment_fn) const {
+        const size_t segments = SegmentCount(pool);
+        if (segments == 0) {
+            return;
+        }
+        const size_t base_length = size_ / segments;
+        const size_t longer = size_ % segments;
+        std::vector<NodeBase*> starts(segments);
+        NodeBase* node = head_.next_node;
+        for (size_t i = 0; i < segments; ++i) {
+            starts[i] = node;
+            for (size_t k = base_length + (i < longer ? 1 : 0); k > 0; --k) {
+                node = node->next_node;
+            }
+        }
+        auto task = [&](size_t i) {
+            segment_fn(i, starts[i], base_length + (i < longer ? 1 : 0));
+        };
+        pool.Run(segments, task);
+    }
+
+    // Находит последний узел после перестановки узлов
+    void RestoreTail() noexcept {
+        tail_ = &head_;
+        while (tail_->next_node != nullptr) {
+            tail_ = tail_->next_node;
+        }
+    }
+
+    // Создаёт узел в памяти аллокатора, конструируя значение из args.
+    // Если конструктор Type выбросит исключение, память вернётся аллокатору
+    template <typename... Args>
+    Node* CreateNode(NodeBase* next, Args&&... args) {
+        Node* node = AllocateNode();
+        StatsPolicy().OnAllocate(1);
+        try {
+            NodeTraits::construct(Alloc(), node, std::in_place, next, std::forward<Args>(args)...);
+        } catch (...) {
+            DeallocateNode(node);
+            throw;
+        }
+        return node;
+    }
+
+    // Выделяет память под узел: сначала во встроенных слотах, затем у аллокатора
+    Node* AllocateNode() {
+        if (void* slot = Slots().TryAllocate()) {
+            return static_cast<Node*>(slot);
+        }
+        return NodeTraits::allocate(Alloc(), 1);
+    }
+
+    void DeallocateNode(Node* node) noexcept {
+        if (Slots().Owns(node)) {
+            Slots().Deallocate(node);
+            return;
+        }
+        NodeTraits::deallocate(Alloc(), node, 1);
+    }
+
+    // Добавляет в конец списка элементы диапазона [first, last).
+    // Для прямых итераторов число элементов известно заранее, и узлы выделяются одним участком
+    template <typename Iter>
+    void AppendRange(Iter first, Iter last) {
+        if constexpr (detail::IS_FORWARD_ITERATOR<Iter>) {
+            AppendNodes(static_cast<size_t>(std::distance(first, last)), [this, &first](Node* node) {
+                NodeTraits::construct(Alloc(), node, std::in_place, nullptr, *first);
+                ++first;
+            });
+        } else {
+            for (; first != last; ++first) {
+                LinkBack(CreateNode(nullptr, *first));
+            }
+        }
+    }
+
+    void AppendCopies(size_t count, const Type& value) {
+        AppendNodes(count, [this, &value](Node* node) {
+            NodeTraits::construct(Alloc(), node, std::in_place, nullptr, value);
+        });
+    }
+
+    // Добавляет в конец списка count узлов, значения которых создаёт construct(node).
+    // Если аллокатор умеет выделять участки, память под все узлы выделяется разом.
+    // При исключении уже созданные узлы остаются в списке, а невостребованная память возвращается аллокатору
+    template <typename ConstructFn>
+    void AppendNodes(size_t count, ConstructFn construct) {
+        // Свободные встроенные слоты занимаются первыми
+        for (; count > 0 && Slots().Free() > 0; --count) {
+            AppendNode(construct);
+        }
+        if constexpr (detail::SupportsBatchAllocation<NodeAllocator>::value) {
+            Node* storage = count > 1 ? Alloc().AllocateBatch(count) : nullptr;
+            if (storage != nullptr) {
+                size_t constructed = 0;
+                try {
+                    for (; constructed < count; ++constructed) {
+                        construct(storage + constructed);
+                        LinkBack(storage + constructed);
+                    }
+                } catch (...) {
+                    for (size_t i = constructed; i < count; ++i) {
+                        NodeTraits::deallocate(Alloc(), storage + i, 1);
+                    }
+                    throw;
+                }
+                StatsPolicy().OnAllocate(count);
+                return;
+            }
+        }
+        for (size_t i = 0; i < count; ++i) {
+            AppendNode(construct);
+        }
+    }
+
+    template <typename ConstructFn>
+    void AppendNode(ConstructFn& construct) {
+        Node* node = AllocateNode();
+        try {
+            construct(node);
+        } catch (...) {
+            DeallocateNode(node);
+            throw;
+        }
+        LinkBack(node);
+        StatsPolicy().OnAllocate(1);
+    }
+
+    void LinkBack(NodeBase* node) noexcept {
+        node->next_node = nullptr;
+        tail_->next_node = node;
+        tail_ = node;
+        ++size_;
+        StatsPolicy().OnSize(size_);
+    }
+
+    // Переносит все узлы chain в этот список после узла pos за время O(1).
+    // Узлы из встроенных слотов chain должны быть заранее перенесены через AdoptInlineNodes.
+    // Возвращает итератор на последний перенесённый элемент либо pos, если chain пуст
+    Iterator LinkChainAfter(NodeBase* pos, SingleLinkedList& chain) noexcept {
+        assert(chain.Slots().Used() == 0);
+        if (chain.IsEmpty()) {
+            return Iterator{ pos };
+        }
+        NodeBase* last = chain.tail_;
+        last->next_node = pos->next_node;
+        pos->next_node = chain.head_.next_node;
+        if (pos == tail_) {
+            tail_ = last;
+        }
+        size_ += chain.size_;
+        StatsPolicy().OnSize(size_);
+        chain.head_.next_node = nullptr;
+        chain.tail_ = &chain.head_;
+        chain.size_ = 0;
+        return Iterator{ last };
+    }
+
+    /*
+     * Переносит в память этого списка узлы интервала (prev, stop) списка from, лежащие во встроенных слотах from.
+     * Узлы занимают свободные встроенные слоты, остальные переносятся в память аллокатора.
+     * Узлы остаются в цепочке from, и их нужно сразу перецепить в этот список.
+     * Если выделить память не удалось, списки не меняются
+     */
+    void AdoptInlineNodes(SingleLinkedList& from, NodeBase* prev, NodeBase* stop) {
+        if (&from == this || from.Slots().Used() == 0) {
+            return;
+        }
+        size_t count = 0;
+        for (NodeBase* node = prev->next_node; node != stop; node = node->next_node) {
+            count += from.Slots().Owns(node) ? 1 : 0;
+        }
+        // Память вне встроенных слотов выделяется заранее, чтобы перенос не прервался исключением
+        std::array<Node*, InlineNodes> spare{};
+        size_t spare_count = 0;
+        try {
+            for (; spare_count + Slots().Free() < count; ++spare_count) {
+                spare[spare_count] = NodeTraits::allocate(Alloc(), 1);
+            }
+        } catch (...) {
+            while (spare_count > 0) {
+                NodeTraits::deallocate(Alloc(), spare[--spare_count], 1);
+            }
+            throw;
+        }
+        for (; count > 0; prev = prev->next_node) {
+            if (from.Slots().Owns(prev->next_node)) {
+                void* slot = Slots().TryAllocate();
+                from.RelocateAfter(prev, slot != nullptr ? slot : spare[--spare_count], from.Slots());
+                --count;
+            }
+        }
+    }
+
+    /*
+     * После обмена цепочками узлы из встроенных слотов other оказались в этом списке,
+     * а узлы из собственных слотов - в other. Переносит их значения в слоты списка, владеющего цепочкой.
+     * Если свободных слотов нет, значение узла временно переносится на стек,
+     * а освободившийся слот other занимает очередной узел other из слотов этого списка
+     */
+    void ExchangeInlineNodes(SingleLinkedList& other) noexcept {
+        size_t foreign = other.Slots().Used();
+        size_t other_foreign = Slots().Used();
+        NodeBase* other_prev = &other.head_;
+        for (NodeBase* prev = &head_; foreign > 0; prev = prev->next_node) {
+            if (!other.Slots().Owns(prev->next_node)) {
+                continue;
+            }
+            if (Slots().Free() > 0) {
+                RelocateAfter(prev, Slots().TryAllocate(), other.Slots());
+            } else {
+                Node* node = static_cast<Node*>(prev->next_node);
+                const bool is_tail = node == tail_;
+                Type value(std::move(node->value));
+                prev->next_node = node->next_node;
+                NodeTraits::destroy(Alloc(), node);
+                other.Slots().Deallocate(node);
+
+                other_prev = other.RelocateNextFrom(other_prev, Slots());
+                --other_foreign;
+
+                Node* fresh = static_cast<Node*>(Slots().TryAllocate());
+                assert(fresh != nullptr);
+                NodeTraits::construct(Alloc(), fresh, std::in_place, prev->next_node, std::move(value));
+                prev->next_node = fresh;
+                if (is_tail) {
+                    tail_ = fresh;
+                }
+            }
+            --foreign;
+        }
+        for (; other_foreign > 0; --other_foreign) {
+            other_prev = other.RelocateNextFrom(other_prev, Slots());
+        }
+    }
+
+    // Находит после prev ближайший узел из слотов from и переносит его в собственный слот.
+    // Возвращает перенесённый узел
+    NodeBase* RelocateNextFrom(NodeBase* prev, InlineSlots& from) noexcept {
+        while (!from.Owns(prev->next_node)) {
+            prev = prev->next_node;
+        }
+        void* slot = Slots().TryAllocate();
+        assert(slot != nullptr);
+        return RelocateAfter(prev, slot, from);
+    }
+
+    // Переносит значение узла, следующего за prev, в новый узел в памяти slot.
+    // Память исходного узла возвращается в слоты from
+    Node* RelocateAfter(NodeBase* prev, void* slot, InlineSlots& from) noexcept {
+        Node* node = static_cast<Node*>(prev->next_node);
+        Node* fresh = static_cast<Node*>(slot);
+        NodeTraits::construct(Alloc(), fresh, std::in_place, node->next_node, std::move(node->value));
+        if (tail_ == node) {
+            tail_ = fresh;
+        }
+        prev->next_node = fresh;
+        NodeTraits::destroy(Alloc(), node);
+        from.Deallocate(node);
+        return fresh;
+    }
+
+    // Разрушает узлы цепочки, начинающейся с node, и освобождает их память
+    void ReleaseChain(NodeBase* node) noexcept {
+        while (node != nullptr) {
+            Node* current = static_cast<Node*>(node);
+            node = node->next_node;
+            NodeTraits::destroy(Alloc(), current);
+            DeallocateNode(current);
+        }
+    }
+
+    void DestroyNode(NodeBase* base) noexcept {
+        Node* node = static_cast<Node*>(base);
+        NodeTraits::destroy(Alloc(), node);
+        DeallocateNode(node);
+        StatsPolicy().OnFree(1);
+    }
+
+    Stats& StatsPolicy() noexcept {
+        return *this;
+    }
+
+    NodeAllocator& Alloc() noexcept {
+        return head_;
+    }
+
+    const NodeAllocator& Alloc() const noexcept {
+        return head_;
+    }
+
+    InlineSlots& Slots() noexcept {
+        return head_;
+    }
+
+    const InlineSlots& Slots() const noexcept {
+        return head_;
+    }
+
+    // Фиктивный узел, используется для вставки "перед первым элементом"
+    Sentinel head_;
+    // Последний узел списка, у пустого списка указывает на head_
+    NodeBase* tail_ = &head_;
+    size_t size_ = 0;
 };
+template <typename Type, typename Allocator, typename Stats, size_t InlineNodes>
+void swap(SingleLinkedList<Type, Allocator, Stats, InlineNodes>& lhs, SingleLinkedList<Type, Allocator, Stats, InlineNodes>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// Списки разной длины не равны, это проверяется за O(1) до обхода элементов
+template <typename Type, typename Allocator, typename Stats, size_t InlineNodes>
+bool operator==(const SingleLinkedList<Type, Allocator, Stats, InlineNodes>& lhs, const SingleLinkedList<Type, Allocator, Stats, InlineNodes>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, typename Allocator, typename Stats, size_t InlineNodes>
+bool operator!=(const SingleLinkedList<Type, Allocator, Stats, InlineNodes>& lhs, const SingleLinkedList<Type, Allocator, Stats, InlineNodes>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Allocator, typename Stats, size_t InlineNodes>
+bool operator<(const SingleLinkedList<Type, Allocator, Stats, InlineNodes>& lhs, const SingleLinkedList<Type, Allocator, Stats, InlineNodes>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, typename Allocator, typename Stats, size_t InlineNodes>
+bool operator<=(const SingleLinkedList<Type, Allocator, Stats, InlineNodes>& lhs, const SingleLinkedList<Type, Allocator, Stats, InlineNodes>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename Allocator, typename Stats, size_t InlineNodes>
+bool operator>(const SingleLinkedList<Type, Allocator, Stats, InlineNodes>& lhs, const SingleLinkedList<Type, Allocator, Stats, InlineNodes>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename Allocator, typename Stats, size_t InlineNodes>
+bool operator>=(const SingleLinkedList<Type, Allocator, Stats, InlineNodes>& lhs, const SingleLinkedList<Type, Allocator, Stats, InlineNodes>& rhs) {
+    return !(lhs < rhs);
+}
 
-// внешние функции разместите здесь
+// Список, первые N узлов которого хранятся прямо в объекте списка
+template <typename Type, size_t N, typename Allocator = std::allocator<Type>>
+using SmallSingleLinkedList = SingleLinkedList<Type, Allocator, NoListStats, N>;
@@ -0,0 +1,573 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace detail {
+
+// Типы, значения которых равны тогда и только тогда, когда равны их байты:
+// целые числа, перечисления и указатели. Участки таких элементов сравниваются через memcmp
+template <typename Type>
+inline constexpr bool IS_BITWISE_COMPARABLE = (std::is_integral_v<Type> || std::is_enum_v<Type> || std::is_pointer_v<Type>)
+    && std::has_unique_object_representations_v<Type>;
+
+}  // namespace detail
+
+// Развёрнутый односвязный список: каждый узел (блок) хранит до ChunkCapacity элементов подряд.
+// Обход и сравнение идут по непрерывным участкам памяти, поэтому промах кэша
+// приходится на блок элементов, а не на каждый элемент.
+// Семантика итераторов, InsertAfter и EraseAfter совпадает с SingleLinkedList,
+// но вставка и удаление делают недействительными итераторы на элементы того же блока
+// и соседнего блока, с которым он был разделён или объединён
+template <typename Type, size_t ChunkCapacity = std::max<size_t>(4, 256 / sizeof(Type))>
+class UnrolledLinkedList {
+    static_assert(ChunkCapacity >= 2, "Блок должен вмещать хотя бы два элемента");
+
+    // Связующая часть блока. Фиктивный блок перед первым состоит только из неё
+    struct ChunkLink {
+        ChunkLink* next_chunk = nullptr;
+        size_t count = 0;
+    };
+
+    struct Chunk : ChunkLink {
+        [[nodiscard]] Type* Data() noexcept {
+            return std::launder(reinterpret_cast<Type*>(storage));
+        }
+
+        alignas(Type) unsigned char storage[sizeof(Type) * ChunkCapacity];
+    };
+
+    // Итератор хранит блок и номер элемента в нём.
+    // Итератор before_begin ссылается на фиктивный блок, в котором нет элементов,
+    // поэтому инкремент сразу переводит его на первый элемент
+    template <typename ValueType>
+    class BasicIterator {
+        friend class UnrolledLinkedList;
+
+        BasicIterator(ChunkLink* chunk, size_t index) noexcept
+            : chunk_(chunk)
+            , index_(index) {
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueType*;
+        using reference = ValueType&;
+
+        BasicIterator() = default;
+
+        BasicIterator(const BasicIterator<Type>& other) noexcept
+            : chunk_(other.chunk_)
+            , index_(other.index_) {
+        }
+
+        BasicIterator& operator=(const BasicIterator& rhs) = default;
+
+        [[nodiscard]] bool operator==(const BasicIterator<const Type>& rhs) const noexcept {
+            return chunk_ == rhs.chunk_ && index_ == rhs.index_;
+        }
+
+        [[nodiscard]] bool operator!=(const BasicIterator<const Type>& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+        [[nodiscard]] bool operator==(const BasicIterator<Type>& rhs) const noexcept {
+            return chunk_ == rhs.chunk_ && index_ == rhs.index_;
+        }
+
+        [[nodiscard]] bool operator!=(const BasicIterator<Type>& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+        // Переход к следующему элементу. Внутри блока это инкремент индекса,
+        // переход по указателю происходит только на границе блока
+        BasicIterator& operator++() noexcept {
+            if (++index_ >= chunk_->count) {
+                chunk_ = chunk_->next_chunk;
+                index_ = 0;
+            }
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            auto old_value(*this);
+            ++(*this);
+            return old_value;
+        }
+
+        [[nodiscard]] reference operator*() const noexcept {
+            return static_cast<Chunk*>(chunk_)->Data()[index_];
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept {
+            assert(chunk_ != nullptr);
+            return &static_cast<Chunk*>(chunk_)->Data()[index_];
+        }
+
+    private:
+        ChunkLink* chunk_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using value_type = Type;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+
+    UnrolledLinkedList() = default;
+
+    UnrolledLinkedList(std::initializer_list<Type> i_list) {
+        copy_it(i_list.begin(), i_list.end());
+    }
+
+    UnrolledLinkedList(const UnrolledLinkedList& other) {
+        copy_it(other.begin(), other.end());
+    }
+
+    UnrolledLinkedList(UnrolledLinkedList&& other) noexcept {
+        swap(other);
+    }
+
+    UnrolledLinkedList& operator=(const UnrolledLinkedList& rhs) {
+        if (this != &rhs) {
+            UnrolledLinkedList rhs2(rhs);
+            swap(rhs2);
+        }
+        return *this;
+    }
+
+    UnrolledLinkedList& operator=(UnrolledLinkedList&& rhs) noexcept {
+        if (this != &rhs) {
+            UnrolledLinkedList rhs2(std::move(rhs));
+            swap(rhs2);
+        }
+        return *this;
+    }
+
+    ~UnrolledLinkedList() {
+        Clear();
+    }
+
+    // Ёмкость одного блока
+    static constexpr size_t CHUNK_CAPACITY = ChunkCapacity;
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    void PushFront(const Type& value) {
+        EmplaceAfter(cbefore_begin(), value);
+    }
+
+    void PushFront(Type&& value) {
+        EmplaceAfter(cbefore_begin(), std::move(value));
+    }
+
+    // Вставляет элемент в конец списка за время O(1)
+    void PushBack(const Type& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(Type&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (tail_ == &head_) {
+            return *EmplaceAfter(cbefore_begin(), std::forward<Args>(args)...);
+        }
+        return *EmplaceAfter(ConstIterator{ tail_, tail_->count - 1 }, std::forward<Args>(args)...);
+    }
+
+    // Очищает список за время O(количество блоков) для тривиально разрушаемых Type
+    // и за время O(N) для остальных
+    void Clear() noexcept {
+        while (head_.next_chunk != nullptr) {
+            Chunk* chunk = static_cast<Chunk*>(head_.next_chunk);
+            head_.next_chunk = chunk->next_chunk;
+            std::destroy_n(chunk->Data(), chunk->count);
+            delete chunk;
+        }
+        tail_ = &head_;
+        size_ = 0;
+    }
+
+    [[nodiscard]] Iterator begin() noexcept {
+        return Iterator{ head_.next_chunk, 0 };
+    }
+
+    [[nodiscard]] Iterator end() noexcept {
+        return Iterator{ nullptr, 0 };
+    }
+
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        return cbegin();
+    }
+
+    [[nodiscard]] ConstIterator end() const noexcept {
+        return cend();
+    }
+
+    [[nodiscard]] ConstIterator cbegin() const noexcept {
+        return ConstIterator{ head_.next_chunk, 0 };
+    }
+
+    [[nodiscard]] ConstIterator cend() const noexcept {
+        return ConstIterator{ nullptr, 0 };
+    }
+
+    [[nodiscard]] Iterator before_begin() noexcept {
+        return Iterator{ &head_, 0 };
+    }
+
+    [[nodiscard]] ConstIterator cbefore_begin() const noexcept {
+        return ConstIterator{ const_cast<ChunkLink*>(&head_), 0 };
+    }
+
+    [[nodiscard]] ConstIterator before_begin() const noexcept {
+        return cbefore_begin();
+    }
+
+    void swap(UnrolledLinkedList& other) noexcept {
+        std::swap(head_.next_chunk, other.head_.next_chunk);
+        std::swap(tail_, other.tail_);
+        std::swap(size_, other.size_);
+        if (tail_ == &other.head_) {
+            tail_ = &head_;
+        }
+        if (other.tail_ == &head_) {
+            other.tail_ = &other.head_;
+        }
+    }
+
+    Iterator InsertAfter(ConstIterator pos, const Type& value) {
+        return EmplaceAfter(pos, value);
+    }
+
+    Iterator InsertAfter(ConstIterator pos, Type&& value) {
+        return EmplaceAfter(pos, std::move(value));
+    }
+
+    /*
+     * Конструирует элемент из args после элемента, на который указывает pos.
+     * Возвращает итератор на вставленный элемент.
+     * Если блок заполнен, он делится пополам. Вставка сразу за последним элементом
+     * заполненного блока создаёт новый блок, поэтому последовательная вставка в конец
+     * заполняет блоки целиком.
+     * Если при создании элемента будет выброшено исключение, список останется в прежнем состоянии.
+     * Если исключение выбросит перемещение элементов блока при сдвиге или делении, размер и порядок
+     * элементов сохранятся, но часть элементов может остаться в состоянии после перемещения.
+     * Для типов с перемещением noexcept список всегда остаётся в прежнем состоянии
+     */
+    template <typename... Args>
+    Iterator EmplaceAfter(ConstIterator pos, Args&&... args) {
+        ChunkLink* target = pos.chunk_;
+        size_t at = pos.index_ + 1;
+        if (target == &head_) {
+            target = head_.next_chunk;
+            at = 0;
+            if (target == nullptr || target->count == ChunkCapacity) {
+                return EmplaceIntoNewChunk(&head_, std::forward<Args>(args)...);
+            }
+        } else if (target->count == ChunkCapacity) {
+            if (at == ChunkCapacity) {
+                return EmplaceIntoNewChunk(target, std::forward<Args>(args)...);
+            }
+            Split(static_cast<Chunk*>(target));
+            if (at > target->count) {
+                at -= target->count;
+                target = target->next_chunk;
+            }
+        }
+        Chunk* chunk = static_cast<Chunk*>(target);
+        EmplaceIntoChunk(chunk, at, std::forward<Args>(args)...);
+        ++size_;
+        return Iterator{ chunk, at };
+    }
+
+    void PopFront() noexcept {
+        if (!IsEmpty()) {
+            EraseAfter(cbefore_begin());
+        }
+    }
+
+    /*
+     * Удаляет элемент, следующий за pos.
+     * Возвращает итератор на элемент, следующий за удалённым.
+     * Опустевший блок удаляется, а блок, заполненный меньше чем наполовину,
+     * объединяется со следующим, если их элементы помещаются в один блок
+     */
+    Iterator EraseAfter(ConstIterator pos) noexcept {
+        ChunkLink* prev = pos.chunk_;
+        ChunkLink* link = prev;
+        size_t index = pos.index_ + 1;
+        if (index >= link->count) {
+            link = link->next_chunk;
+            index = 0;
+        }
+        assert(link != nullptr);
+
+        Chunk* chunk = static_cast<Chunk*>(link);
+        Type* data = chunk->Data();
+        std::move(data + index + 1, data + chunk->count, data + index);
+        std::destroy_at(data + chunk->count - 1);
+        --chunk->count;
+        --size_;
+
+        if (chunk->count == 0) {
+            // Блок опустел только если в нём был один элемент, значит prev - предыдущий блок
+            Unlink(prev);
+            return Iterator{ prev->next_chunk, 0 };
+        }
+        if (chunk->count <= ChunkCapacity / 2 && chunk->next_chunk != nullptr
+            && chunk->count + chunk->next_chunk->count <= ChunkCapacity) {
+            MergeNext(chunk);
+        }
+        if (index < chunk->count) {
+            return Iterator{ chunk, index };
+        }
+        return Iterator{ chunk->next_chunk, 0 };
+    }
+
+private:
+    template <typename Iter>
+    void copy_it(const Iter begin, const Iter end) {
+        UnrolledLinkedList temp;
+        for (auto b = begin; b != end; ++b) {
+            temp.EmplaceBack(*b);
+        }
+        swap(temp);
+    }
+
+    // Создаёт блок с одним элементом и вставляет его после prev
+    template <typename... Args>
+    Iterator EmplaceIntoNewChunk(ChunkLink* prev, Args&&... args) {
+        Chunk* chunk = new Chunk;
+        try {
+            ::new (static_cast<void*>(chunk->Data())) Type(std::forward<Args>(args)...);
+        } catch (...) {
+            delete chunk;
+            throw;
+        }
+        chunk->count = 1;
+        Link(prev, chunk);
+        ++size_;
+        return Iterator{ chunk, 0 };
+    }
+
+    // Вставляет элемент в незаполненный блок на позицию at, сдвигая хвост блока вправо.
+    // Пока блок не учитывает добавленное место, его освобождает обработчик исключения
+    template <typename... Args>
+    static void EmplaceIntoChunk(Chunk* chunk, size_t at, Args&&... args) {
+        Type* data = chunk->Data();
+        const size_t count = chunk->count;
+        if (at == count) {
+            ::new (static_cast<void*>(data + count)) Type(std::forward<Args>(args)...);
+        } else {
+            Type value(std::forward<Args>(args)...);
+            ::new (static_cast<void*>(data + count)) Type(std::move(data[count - 1]));
+            try {
+                std::move_backward(data + at, data + count - 1, data + count);
+                data[at] = std::move(value);
+            } catch (...) {
+                std::destroy_at(data + count);
+                throw;
+            }
+        }
+        ++chunk->count;
+    }
+
+    // Переносит верхнюю половину заполненного блока в новый блок, вставленный следом.
+    // Пока новый блок не присоединён к списку, им владеет upper: если перемещение элемента
+    // выбросит исключение, блок освобождается, а исходный блок сохраняет все элементы
+    void Split(Chunk* chunk) {
+        // Без value-инициализации: make_unique обнулял бы весь массив элементов при каждом делении
+        std::unique_ptr<Chunk> upper(new Chunk);
+        const size_t keep = ChunkCapacity / 2;
+        Type* data = chunk->Data();
+        std::uninitialized_move(data + keep, data + chunk->count, upper->Data());
+        std::destroy(data + keep, data + chunk->count);
+        upper->count = chunk->count - keep;
+        chunk->count = keep;
+        Link(chunk, upper.release());
+    }
+
+    // Переносит элементы следующего блока в конец chunk и удаляет следующий блок
+    void MergeNext(Chunk* chunk) noexcept {
+        Chunk* next = static_cast<Chunk*>(chunk->next_chunk);
+        Type* next_data = next->Data();
+        std::uninitialized_move(next_data, next_data + next->count, chunk->Data() + chunk->count);
+        std::destroy_n(next_data, next->count);
+        chunk->count += next->count;
+        next->count = 0;
+        Unlink(chunk);
+    }
+
+    void Link(ChunkLink* prev, Chunk* chunk) noexcept {
+        chunk->next_chunk = prev->next_chunk;
+        prev->next_chunk = chunk;
+        if (tail_ == prev) {
+            tail_ = chunk;
+        }
+    }
+
+    // Удаляет пустой блок, следующий за prev
+    void Unlink(ChunkLink* prev) noexcept {
+        Chunk* chunk = static_cast<Chunk*>(prev->next_chunk);
+        assert(chunk->count == 0);
+        prev->next_chunk = chunk->next_chunk;
+        if (tail_ == chunk) {
+            tail_ = prev;
+        }
+        delete chunk;
+    }
+
+    // Курсор по непрерывным участкам элементов, используется при сравнении списков
+    class RunCursor {
+    public:
+        explicit RunCursor(const UnrolledLinkedList& list) noexcept
+            : chunk_(list.head_.next_chunk) {
+        }
+
+        [[nodiscard]] bool AtEnd() const noexcept {
+            return chunk_ == nullptr;
+        }
+
+        [[nodiscard]] const Type* Data() const noexcept {
+            return static_cast<Chunk*>(chunk_)->Data() + index_;
+        }
+
+        [[nodiscard]] size_t Available() const noexcept {
+            return chunk_->count - index_;
+        }
+
+        void Advance(size_t n) noexcept {
+            index_ += n;
+            if (index_ == chunk_->count) {
+                chunk_ = chunk_->next_chunk;
+                index_ = 0;
+            }
+        }
+
+    private:
+        ChunkLink* chunk_;
+        size_t index_ = 0;
+    };
+
+    // Сравнивает на равенство участки из count элементов
+    static bool EqualRuns(const Type* lhs, const Type* rhs, size_t count) {
+        if constexpr (detail::IS_BITWISE_COMPARABLE<Type>) {
+            return std::memcmp(lhs, rhs, count * sizeof(Type)) == 0;
+        } else {
+            return std::equal(lhs, lhs + count, rhs);
+        }
+    }
+
+    template <typename T, size_t C>
+    friend bool operator==(const UnrolledLinkedList<T, C>& lhs, const UnrolledLinkedList<T, C>& rhs);
+
+    template <typename T, size_t C>
+    friend bool operator<(const UnrolledLinkedList<T, C>& lhs, const UnrolledLinkedList<T, C>& rhs);
+
+    // Фиктивный блок перед первым
+    ChunkLink head_;
+    // Последний блок списка, у пустого списка указывает на head_
+    ChunkLink* tail_ = &head_;
+    size_t size_ = 0;
+};
+
+template <typename Type, size_t ChunkCapacity>
+void swap(UnrolledLinkedList<Type, ChunkCapacity>& lhs, UnrolledLinkedList<Type, ChunkCapacity>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// Списки сравниваются участками, общими для обоих списков,
+// внутри участка элементы лежат подряд и сравниваются как массивы
+template <typename Type, size_t ChunkCapacity>
+bool operator==(const UnrolledLinkedList<Type, ChunkCapacity>& lhs, const UnrolledLinkedList<Type, ChunkCapacity>& rhs) {
+    if (lhs.GetSize() != rhs.GetSize()) {
+        return false;
+    }
+    typename UnrolledLinkedList<Type, ChunkCapacity>::RunCursor l(lhs);
+    typename UnrolledLinkedList<Type, ChunkCapacity>::RunCursor r(rhs);
+    while (!l.AtEnd()) {
+        const size_t n = std::min(l.Available(), r.Available());
+        if (!UnrolledLinkedList<Type, ChunkCapacity>::EqualRuns(l.Data(), r.Data(), n)) {
+            return false;
+        }
+        l.Advance(n);
+        r.Advance(n);
+    }
+    return true;
+}
+
+template <typename Type, size_t ChunkCapacity>
+bool operator!=(const UnrolledLinkedList<Type, ChunkCapacity>& lhs, const UnrolledLinkedList<Type, ChunkCapacity>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t ChunkCapacity>
+bool operator<(const UnrolledLinkedList<Type, ChunkCapacity>& lhs, const UnrolledLinkedList<Type, ChunkCapacity>& rhs) {
+    typename UnrolledLinkedList<Type, ChunkCapacity>::RunCursor l(lhs);
+    typename UnrolledLinkedList<Type, ChunkCapacity>::RunCursor r(rhs);
+    while (!l.AtEnd() && !r.AtEnd()) {
+        const size_t n = std::min(l.Available(), r.Available());
+        const Type* l_data = l.Data();
+        const Type* r_data = r.Data();
+        if constexpr (detail::IS_BITWISE_COMPARABLE<Type>) {
+            // Обычно участки совпадают целиком, и поэлементный поиск различия нужен только в одном из них.
+            // Для таких типов несовпадение байтов означает, что один из элементов меньше другого
+            if (std::memcmp(l_data, r_data, n * sizeof(Type)) != 0) {
+                const auto [l_mismatch, r_mismatch] = std::mismatch(l_data, l_data + n, r_data);
+                return *l_mismatch < *r_mismatch;
+            }
+        } else {
+            // Элементы сравниваются только оператором <, как в std::lexicographical_compare:
+            // неравные по == элементы, например NaN, считаются эквивалентными, если ни один не меньше другого
+            for (size_t i = 0; i < n; ++i) {
+                if (l_data[i] < r_data[i]) {
+                    return true;
+                }
+                if (r_data[i] < l_data[i]) {
+                    return false;
+                }
+            }
+        }
+        l.Advance(n);
+        r.Advance(n);
+    }
+    return l.AtEnd() && !r.AtEnd();
+}
+
+template <typename Type, size_t ChunkCapacity>
+bool operator<=(const UnrolledLinkedList<Type, ChunkCapacity>& lhs, const UnrolledLinkedList<Type, ChunkCapacity>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t ChunkCapacity>
+bool operator>(const UnrolledLinkedList<Type, ChunkCapacity>& lhs, const UnrolledLinkedList<Type, ChunkCapacity>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t ChunkCapacity>
+bool operator>=(const UnrolledLinkedList<Type, ChunkCapacity>& lhs, const UnrolledLinkedList<Type, ChunkCapacity>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Пул потоков с перехватом задач. У каждого рабочего потока своя очередь:
+// поток берёт задачи с конца своей очереди, а когда она пуста - забирает задачи
+// из начала чужих очередей. Поток, ожидающий завершения пакета задач, тоже выполняет задачи,
+// поэтому задачи могут запускать вложенные пакеты без риска взаимной блокировки
+class WorkStealingPool {
+public:
+    // threads - число рабочих потоков помимо вызывающего. При 0 задачи выполняет вызывающий поток
+    explicit WorkStealingPool(size_t threads) {
+        queues_.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        workers_.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this, i] {
+                Work(i);
+            });
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard guard(sleep_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    // Общий пул, в котором рабочих потоков на один меньше, чем аппаратных: последним работает вызывающий поток
+    static WorkStealingPool& Instance() {
+        static WorkStealingPool pool(std::max<unsigned>(std::thread::hardware_concurrency(), 1) - 1);
+        return pool;
+    }
+
+    // Число потоков, выполняющих задачи пакета, с учётом вызывающего
+    [[nodiscard]] size_t GetConcurrency() const noexcept {
+        return workers_.size() + 1;
+    }
+
+    /*
+     * Выполняет task(i) для всех i из [0, count) и ждёт завершения всех вызовов.
+     * Если какой-то вызов выбросит исключение, остальные всё равно выполняются,
+     * а первое исключение выбрасывается из Run
+     */
+    template <typename Task>
+    void Run(size_t count, Task& task) {
+        if (count == 0) {
+            return;
+        }
+        if (workers_.empty() || count == 1) {
+            for (size_t i = 0; i < count; ++i) {
+                task(i);
+            }
+            return;
+        }
+
+        Batch batch;
+        batch.remaining = count;
+        // Свою очередь у вызывающего потока есть, только если он сам рабочий поток этого пула
+        const size_t home = current_pool_ == this ? current_index_ : 0;
+        size_t pushed = 0;
+        try {
+            for (; pushed < count; ++pushed) {
+                Push((home + pushed) % queues_.size(), [&batch, &task, i = pushed] {
+                    try {
+                        task(i);
+                    } catch (...) {
+                        batch.SetError(std::current_exception());
+                    }
+                    std::lock_guard guard(batch.mutex);
+                    if (--batch.remaining == 0) {
+                        batch.done.notify_all();
+                    }
+                });
+            }
+        } catch (...) {
+            // Задачи, которые не удалось поставить в очередь, не выполняются,
+            // но уже поставленные ссылаются на batch, поэтому их нужно дождаться
+            batch.SetError(std::current_exception());
+            std::lock_guard guard(batch.mutex);
+            batch.remaining -= count - pushed;
+        }
+
+        // Пока пакет не завершён, вызывающий поток выполняет задачи сам
+        while (true) {
+            {
+                std::unique_lock lock(batch.mutex);
+                if (batch.remaining == 0) {
+                    break;
+                }
+            }
+            if (!TryRunOne(home)) {
+                std::unique_lock lock(batch.mutex);
+                // Оставшиеся задачи пакета уже выполняются другими потоками
+                batch.done.wait_for(lock, std::chrono::milliseconds(1), [&batch] {
+                    return batch.remaining == 0;
+                });
+            }
+        }
+        if (batch.error) {
+            std::rethrow_exception(batch.error);
+        }
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    // Состояние одного вызова Run
+    struct Batch {
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t remaining = 0;
+        std::exception_ptr error;
+
+        void SetError(std::exception_ptr exception) {
+            std::lock_guard guard(mutex);
+            if (!error) {
+                error = std::move(exception);
+            }
+        }
+    };
+
+    void Push(size_t index, std::function<void()> task) {
+        // Счётчик увеличивается до вставки, чтобы забравший задачу поток не увёл его ниже нуля
+        pending_.fetch_add(1, std::memory_order_release);
+        try {
+            std::lock_guard guard(queues_[index]->mutex);
+            queues_[index]->tasks.push_back(std::move(task));
+        } catch (...) {
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+        {
+            std::lock_guard guard(sleep_mutex_);
+        }
+        wake_.notify_one();
+    }
+
+    // Выполняет одну задачу: сначала с конца очереди home, затем из начала чужих очередей
+    bool TryRunOne(size_t home) {
+        std::function<void()> task;
+        {
+            Queue& own = *queues_[home];
+            std::lock_guard guard(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+            }
+        }
+        for (size_t step = 1; !task && step < queues_.size(); ++step) {
+            Queue& victim = *queues_[(home + step) % queues_.size()];
+            std::lock_guard guard(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+            }
+        }
+        if (!task) {
+            return false;
+        }
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        return true;
+    }
+
+    void Work(size_t index) {
+        current_pool_ = this;
+        current_index_ = index;
+        while (true) {
+            if (TryRunOne(index)) {
+                continue;
+            }
+            std::unique_lock lock(sleep_mutex_);
+            wake_.wait(lock, [this] {
+                return stop_ || pending_.load(std::memory_order_acquire) > 0;
+            });
+            if (stop_) {
+                return;
+            }
+        }
+    }
+
+    // Пул и номер очереди рабочего потока, в котором выполняется код
+    static inline thread_local WorkStealingPool* current_pool_ = nullptr;
+    static inline thread_local size_t current_index_ = 0;
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::atomic<size_t> pending_{ 0 };
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+    // Потоки запускаются последними, когда остальные поля уже созданы
+    std::vector<std::thread> workers_;
+};